@@ -0,0 +1,785 @@
+// CPU micro-benchmarks for engine subsystems that do not need a GL context.
+// Usage: PerfBench [name...]   (no arguments runs every benchmark)
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "BVH.h"
+#include "Collision.h"
+#include "CollisionWorld.h"
+#include "ColliderGrid.h"
+#include "JobSystem.h"
+#include "MeshNode.h"
+#include "ParticleKernels.h"
+#include "Random.h"
+#include "SceneNode.h"
+#include "Transform.h"
+#include "TransformHierarchy.h"
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // Keeps results observable so the optimizer cannot drop the measured work
+    volatile float g_sink = 0.0f;
+
+    double ElapsedMs(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // ------------------------------------------------------------------
+    // Collision: per-frame player queries, old (copy + linear scan) vs CollisionWorld
+    // ------------------------------------------------------------------
+
+    constexpr int kDoorCount = 40;
+    constexpr int kOverlapQueriesPerFrame = 7; // worst case of Player::ProcessInputs
+    constexpr int kFrames = 2000;
+
+    std::vector<AABB> MakeRandomBoxes(size_t count, float extent, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<float> pos(-extent, extent);
+        std::uniform_real_distribution<float> size(0.3f, 4.0f);
+        std::uniform_real_distribution<float> height(0.1f, 6.0f);
+
+        std::vector<AABB> boxes(count);
+        for (AABB& b : boxes)
+        {
+            const glm::vec3 c(pos(rng), 0.0f, pos(rng));
+            const glm::vec3 half(size(rng) * 0.5f, height(rng), size(rng) * 0.5f);
+            b.min = glm::vec3(c.x - half.x, 0.0f, c.z - half.z);
+            b.max = glm::vec3(c.x + half.x, half.y, c.z + half.z);
+        }
+        return boxes;
+    }
+
+    AABB PlayerBox(const glm::vec3& eye)
+    {
+        AABB box;
+        box.min = glm::vec3(eye.x - 0.3f, eye.y - 1.7f + 0.25f, eye.z - 0.3f);
+        box.max = glm::vec3(eye.x + 0.3f, eye.y + 0.1f, eye.z + 0.3f);
+        return box;
+    }
+
+    float FloorFrom(const AABB& player, const AABB& box, float bestY)
+    {
+        if (player.min.x <= box.max.x && player.max.x >= box.min.x &&
+            player.min.z <= box.max.z && player.max.z >= box.min.z &&
+            box.max.y <= player.min.y + 0.5f)
+        {
+            return std::max(bestY, box.max.y);
+        }
+        return bestY;
+    }
+
+    void BenchCollision()
+    {
+        std::printf("\n[collision] %d frames, %d overlap + 1 floor query per frame, %d doors\n",
+                    kFrames, kOverlapQueriesPerFrame, kDoorCount);
+        std::printf("%10s %18s %18s %10s\n", "colliders", "copy+scan us/frame", "world us/frame", "speedup");
+
+        for (size_t count : { 1000u, 4000u, 16000u, 64000u })
+        {
+            std::mt19937 rng(42u);
+            const float extent = 50.0f * std::sqrt(static_cast<float>(count) / 1000.0f); // constant density
+            const std::vector<AABB> staticBoxes = MakeRandomBoxes(count, extent, rng);
+            const std::vector<AABB> doorBoxes = MakeRandomBoxes(kDoorCount, extent, rng);
+
+            std::uniform_real_distribution<float> walk(-extent, extent);
+            std::vector<glm::vec3> eyes(kFrames);
+            for (glm::vec3& e : eyes) e = glm::vec3(walk(rng), 1.7f, walk(rng));
+
+            // Old path: copy the static vector, append doors, linear scans
+            const auto oldStart = Clock::now();
+            float oldAcc = 0.0f;
+            for (int f = 0; f < kFrames; ++f)
+            {
+                std::vector<AABB> frameColliders = staticBoxes;
+                for (int d = 0; d < kDoorCount; ++d)
+                {
+                    if ((d + f) % 3 != 0) frameColliders.push_back(doorBoxes[d]);
+                }
+
+                const AABB player = PlayerBox(eyes[f]);
+                for (int q = 0; q < kOverlapQueriesPerFrame; ++q)
+                {
+                    for (const AABB& b : frameColliders)
+                    {
+                        if (player.Overlaps(b)) { oldAcc += 1.0f; break; }
+                    }
+                }
+                float bestY = -FLT_MAX;
+                for (const AABB& b : frameColliders) bestY = FloorFrom(player, b, bestY);
+                oldAcc += bestY;
+            }
+            const double oldMs = ElapsedMs(oldStart);
+
+            // New path: static grid + persistent dynamic slots updated in place
+            CollisionWorld world;
+            world.SetStatic(staticBoxes);
+            std::vector<CollisionWorld::DynamicHandle> doors;
+            for (const AABB& b : doorBoxes) doors.push_back(world.AddDynamic(b));
+
+            const auto newStart = Clock::now();
+            float newAcc = 0.0f;
+            for (int f = 0; f < kFrames; ++f)
+            {
+                for (int d = 0; d < kDoorCount; ++d)
+                {
+                    world.SetDynamicEnabled(doors[d], (d + f) % 3 != 0);
+                    world.SetDynamic(doors[d], doorBoxes[d]);
+                }
+
+                const AABB player = PlayerBox(eyes[f]);
+                for (int q = 0; q < kOverlapQueriesPerFrame; ++q)
+                {
+                    if (world.Overlaps(player)) newAcc += 1.0f;
+                }
+                float bestY = -FLT_MAX;
+                world.ForEachCandidate(glm::vec2(player.min.x, player.min.z), glm::vec2(player.max.x, player.max.z),
+                                       [&](const AABB& b) { bestY = FloorFrom(player, b, bestY); });
+                newAcc += bestY;
+            }
+            const double newMs = ElapsedMs(newStart);
+
+            g_sink = g_sink + oldAcc + newAcc;
+            const double oldUs = oldMs * 1000.0 / kFrames;
+            const double newUs = newMs * 1000.0 / kFrames;
+            std::printf("%10zu %18.2f %18.2f %9.1fx\n", count, oldUs, newUs, oldUs / std::max(newUs, 1e-6));
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Raycast: BVH closest-hit queries vs a linear scan over every box
+    // ------------------------------------------------------------------
+
+    bool RayBox(const glm::vec3& origin, const glm::vec3& invDir, const AABB& box, float tMax, float& t)
+    {
+        const glm::vec3 t0 = (box.min - origin) * invDir;
+        const glm::vec3 t1 = (box.max - origin) * invDir;
+        const glm::vec3 lo = glm::min(t0, t1);
+        const glm::vec3 hi = glm::max(t0, t1);
+        const float tNear = std::max(std::max(lo.x, lo.y), std::max(lo.z, 0.0f));
+        const float tFar = std::min(std::min(hi.x, hi.y), std::min(hi.z, tMax));
+        if (tNear > tFar) return false;
+        t = tNear;
+        return true;
+    }
+
+    void BenchRaycast()
+    {
+        constexpr int kRays = 10000;
+        std::printf("\n[raycast] %d closest-hit rays from eye height, 50 m reach\n", kRays);
+        std::printf("%10s %12s %16s %16s %10s\n", "boxes", "build ms", "linear us/ray", "bvh us/ray", "speedup");
+
+        for (size_t count : { 1000u, 10000u, 100000u })
+        {
+            std::mt19937 rng(7u);
+            const float extent = 50.0f * std::sqrt(static_cast<float>(count) / 1000.0f);
+            const std::vector<AABB> boxes = MakeRandomBoxes(count, extent, rng);
+
+            std::uniform_real_distribution<float> pos(-extent, extent);
+            std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+            std::uniform_real_distribution<float> pitch(-0.5f, 0.2f);
+            std::vector<glm::vec3> origins(kRays), dirs(kRays);
+            for (int i = 0; i < kRays; ++i)
+            {
+                origins[i] = glm::vec3(pos(rng), 1.7f, pos(rng));
+                const float a = angle(rng), p = pitch(rng);
+                dirs[i] = glm::normalize(glm::vec3(std::cos(a), p, std::sin(a)));
+            }
+
+            const auto buildStart = Clock::now();
+            BVH bvh;
+            bvh.Build(boxes);
+            const double buildMs = ElapsedMs(buildStart);
+
+            const auto linearStart = Clock::now();
+            float linearAcc = 0.0f;
+            for (int i = 0; i < kRays; ++i)
+            {
+                const glm::vec3 invDir = 1.0f / dirs[i];
+                float tMax = 50.0f, t = 0.0f;
+                for (const AABB& b : boxes)
+                {
+                    if (RayBox(origins[i], invDir, b, tMax, t)) tMax = t;
+                }
+                linearAcc += tMax;
+            }
+            const double linearMs = ElapsedMs(linearStart);
+
+            const auto bvhStart = Clock::now();
+            float bvhAcc = 0.0f;
+            for (int i = 0; i < kRays; ++i)
+            {
+                const glm::vec3 invDir = 1.0f / dirs[i];
+                float tMax = 50.0f;
+                bvh.Raycast(origins[i], dirs[i], tMax, [&](uint32_t item, float& maxT) {
+                    float t = 0.0f;
+                    if (RayBox(origins[i], invDir, boxes[item], maxT, t)) maxT = t;
+                });
+                bvhAcc += tMax;
+            }
+            const double bvhMs = ElapsedMs(bvhStart);
+
+            g_sink = g_sink + linearAcc + bvhAcc;
+            const double linearUs = linearMs * 1000.0 / kRays;
+            const double bvhUs = bvhMs * 1000.0 / kRays;
+            std::printf("%10zu %12.2f %16.3f %16.3f %9.1fx%s\n", count, buildMs, linearUs, bvhUs,
+                        linearUs / std::max(bvhUs, 1e-6),
+                        std::abs(linearAcc - bvhAcc) > 1e-2f * kRays ? "  (MISMATCH)" : "");
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Particles: fountain integration step, old AoS loop vs SoA scalar vs SoA SIMD
+    // ------------------------------------------------------------------
+
+    struct AosParticle
+    {
+        glm::vec3 position;
+        glm::vec3 velocity;
+        glm::vec4 color;
+        float life;
+    };
+
+    // The ParticleSystem::Update loop before the SoA conversion (without the removal of dead particles)
+    void IntegrateAos(std::vector<AosParticle>& particles, const ParticleIntegrateParams& params, float floorY)
+    {
+        for (AosParticle& p : particles)
+        {
+            p.life -= params.dt;
+            p.velocity += params.gravity * params.dt;
+            p.position += p.velocity * params.dt;
+            p.color.a -= params.dt * params.fadeRate;
+            if (p.position.y < floorY)
+            {
+                p.position.y = floorY;
+                p.velocity.y = -p.velocity.y * params.bounce;
+                p.velocity.x *= params.friction;
+                p.velocity.z *= params.friction;
+            }
+        }
+    }
+
+    void BenchParticles()
+    {
+        constexpr int kSteps = 100;
+
+        std::printf("\n[particles] %d integration steps, SIMD path: %s\n", kSteps, ParticleKernels::GetSimdName());
+        std::printf("%10s %14s %14s %14s %10s\n", "particles", "AoS ms/step", "SoA ms/step", "SIMD ms/step", "speedup");
+
+        constexpr float kFloorY = 5.8f;
+        ParticleIntegrateParams params;
+        params.dt = 1.0f / 60.0f;
+
+        for (size_t count : { size_t(10000), size_t(100000), size_t(1000000) })
+        {
+            // Same initial state for all three variants: a jet launched just above the floor
+            std::mt19937 rng(99);
+            std::uniform_real_distribution<float> spread(-0.3f, 0.3f);
+            std::uniform_real_distribution<float> up(5.0f, 7.5f);
+
+            std::vector<AosParticle> aos(count);
+            ParticleSoA soa;
+            soa.Resize(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                AosParticle& p = aos[i];
+                p.position = glm::vec3(28.0f, 6.8f, 18.0f);
+                p.velocity = glm::vec3(spread(rng), up(rng), spread(rng));
+                p.color = glm::vec4(0.6f, 0.8f, 1.0f, 1.0f);
+                p.life = 1e6f; // keep everything alive so all variants do the same work
+                soa.Set(i, p.position, p.velocity, p.color, p.life, kFloorY);
+            }
+            ParticleSoA simd = soa;
+
+            auto start = Clock::now();
+            for (int s = 0; s < kSteps; ++s) IntegrateAos(aos, params, kFloorY);
+            const double aosMs = ElapsedMs(start) / kSteps;
+
+            start = Clock::now();
+            for (int s = 0; s < kSteps; ++s) ParticleKernels::IntegrateScalar(soa, count, params);
+            const double soaMs = ElapsedMs(start) / kSteps;
+
+            start = Clock::now();
+            for (int s = 0; s < kSteps; ++s) ParticleKernels::Integrate(simd, count, params);
+            const double simdMs = ElapsedMs(start) / kSteps;
+
+            // All variants must agree (up to rounding)
+            float maxError = 0.0f;
+            for (size_t i = 0; i < count; ++i)
+            {
+                maxError = std::max(maxError, std::abs(aos[i].position.y - simd.posY[i]));
+                maxError = std::max(maxError, std::abs(soa.posY[i] - simd.posY[i]));
+            }
+            g_sink = g_sink + simd.posY[count / 2];
+
+            std::printf("%10zu %14.3f %14.3f %14.3f %9.1fx%s\n", count, aosMs, soaMs, simdMs,
+                        aosMs / std::max(simdMs, 1e-6), maxError > 1e-3f ? "  (MISMATCH)" : "");
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // RNG: rand() vs xoshiro128+ (scalar and 4-lane batch), plus a determinism check
+    // ------------------------------------------------------------------
+
+    void BenchRandom()
+    {
+        constexpr size_t kCount = 1 << 24;
+        constexpr uint64_t kSeed = 1234;
+
+        std::printf("\n[rng] %zu floats in [0, 1)\n", kCount);
+        std::printf("%18s %12s %14s\n", "generator", "ns/float", "checksum");
+
+        std::vector<float> values(kCount);
+        auto checksum = [&values]() {
+            double sum = 0.0;
+            for (float v : values) sum += v;
+            return sum;
+        };
+
+        std::srand(static_cast<unsigned>(kSeed));
+        auto start = Clock::now();
+        for (float& v : values) v = static_cast<float>(std::rand()) / (static_cast<float>(RAND_MAX) + 1.0f);
+        double ms = ElapsedMs(start);
+        std::printf("%18s %12.3f %14.3f\n", "rand()", ms * 1e6 / kCount, checksum());
+
+        Xoshiro128Plus scalar(kSeed);
+        start = Clock::now();
+        for (float& v : values) v = scalar.NextFloat();
+        ms = ElapsedMs(start);
+        std::printf("%18s %12.3f %14.3f\n", "xoshiro128+", ms * 1e6 / kCount, checksum());
+
+        Xoshiro128Plus4 batch(kSeed);
+        start = Clock::now();
+        batch.Fill(values.data(), values.size());
+        ms = ElapsedMs(start);
+        const double batchSum = checksum();
+        std::printf("%18s %12.3f %14.3f\n", "xoshiro128+ x4", ms * 1e6 / kCount, batchSum);
+
+        // Same seed, same numbers: reseeding must reproduce the batch exactly
+        batch.Seed(kSeed);
+        std::vector<float> again(kCount);
+        batch.Fill(again.data(), again.size());
+        const bool reproducible = std::memcmp(values.data(), again.data(), kCount * sizeof(float)) == 0;
+        std::printf("reseeded batch %s\n", reproducible ? "matches bit for bit" : "DIFFERS (MISMATCH)");
+        g_sink = g_sink + again[kCount / 2];
+    }
+
+    // ------------------------------------------------------------------
+    // Jobs: chunked particle integration on the JobSystem, 1..N threads
+    // ------------------------------------------------------------------
+
+    void BenchJobs()
+    {
+        constexpr size_t kCount = 1000000;
+        constexpr size_t kChunkSize = 16384; // same as ParticleManager
+        constexpr int kSteps = 100;
+        const unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+
+        std::printf("\n[jobs] %zu particles, %d steps, chunks of %zu, SIMD path: %s\n",
+                    kCount, kSteps, kChunkSize, ParticleKernels::GetSimdName());
+        std::printf("%8s %12s %10s %12s\n", "threads", "ms/step", "speedup", "efficiency");
+
+        ParticleIntegrateParams params;
+        params.dt = 1.0f / 60.0f;
+
+        // 1, 2, 3, 4, 8, 16, ... and always the full machine
+        std::vector<unsigned int> threadCounts;
+        for (unsigned int t = 1; t < maxThreads; t = (t < 4 ? t + 1 : t * 2))
+            threadCounts.push_back(t);
+        threadCounts.push_back(maxThreads);
+
+        double baseMs = 0.0;
+        for (unsigned int threads : threadCounts)
+        {
+            ParticleSoA soa;
+            soa.Resize(kCount);
+            std::mt19937 rng(99);
+            std::uniform_real_distribution<float> up(5.0f, 7.5f);
+            for (size_t i = 0; i < kCount; ++i)
+                soa.Set(i, glm::vec3(28.0f, 6.8f, 18.0f), glm::vec3(0.0f, up(rng), 0.0f), glm::vec4(1.0f), 1e6f, 5.8f);
+
+            // The calling thread helps, so N threads = N - 1 workers
+            JobSystem jobs(threads - 1);
+            const auto start = Clock::now();
+            for (int s = 0; s < kSteps; ++s)
+            {
+                jobs.ParallelFor(kCount, kChunkSize, [&soa, &params](size_t begin, size_t end) {
+                    ParticleKernels::Integrate(soa, begin, end, params);
+                });
+            }
+            const double ms = ElapsedMs(start) / kSteps;
+            g_sink = g_sink + soa.posY[kCount / 2];
+
+            if (threads == 1) baseMs = ms;
+            const double speedup = baseMs / std::max(ms, 1e-9);
+            std::printf("%8u %12.3f %9.2fx %11.0f%%\n", threads, ms, speedup, 100.0 * speedup / threads);
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Particle collision: 100k particles against world boxes, linear scan vs ColliderGrid
+    // ------------------------------------------------------------------
+
+    void BenchParticleCollision()
+    {
+        constexpr size_t kCount = 100000;
+        constexpr int kGridSteps = 20;
+
+        std::printf("\n[particle-collision] %zu particles per step\n", kCount);
+        std::printf("%10s %16s %16s %10s\n", "colliders", "linear ms/step", "grid ms/step", "speedup");
+
+        ParticleIntegrateParams params;
+        params.dt = 1.0f / 60.0f;
+
+        for (size_t boxCount : { size_t(1000), size_t(10000) })
+        {
+            std::mt19937 rng(7);
+            const std::vector<AABB> boxes = MakeRandomBoxes(boxCount, 100.0f, rng);
+
+            // A grid with one giant cell visits every box for every particle: the linear scan
+            ColliderGrid linear, grid;
+            linear.Build(boxes, 1e6f);
+            grid.Build(boxes, 4.0f);
+
+            // Particles raining down over the whole area
+            std::uniform_real_distribution<float> pos(-100.0f, 100.0f);
+            std::uniform_real_distribution<float> height(0.0f, 6.0f);
+            ParticleSoA start;
+            start.Resize(kCount);
+            for (size_t i = 0; i < kCount; ++i)
+                start.Set(i, glm::vec3(pos(rng), height(rng), pos(rng)), glm::vec3(0.0f, -3.0f, 0.0f), glm::vec4(1.0f), 1.0f, 0.0f);
+
+            // One step each is enough for the linear scan (it dominates the run time)
+            ParticleSoA linearResult = start;
+            auto t0 = Clock::now();
+            ParticleKernels::CollideWithBoxes(linearResult, 0, kCount, linear, params);
+            const double linearMs = ElapsedMs(t0);
+
+            ParticleSoA gridResult;
+            double gridMs = 0.0;
+            for (int s = 0; s < kGridSteps; ++s)
+            {
+                gridResult = start;
+                t0 = Clock::now();
+                ParticleKernels::CollideWithBoxes(gridResult, 0, kCount, grid, params);
+                gridMs += ElapsedMs(t0) / kGridSteps;
+            }
+
+            // Both must push the same particles out
+            size_t differing = 0;
+            for (size_t i = 0; i < kCount; ++i)
+            {
+                const bool movedLinear = linearResult.GetPosition(i) != start.GetPosition(i);
+                const bool movedGrid = gridResult.GetPosition(i) != start.GetPosition(i);
+                if (movedLinear != movedGrid) ++differing;
+            }
+            g_sink = g_sink + gridResult.posY[kCount / 2];
+
+            std::printf("%10zu %16.3f %16.3f %9.1fx%s\n", boxCount, linearMs, gridMs,
+                        linearMs / std::max(gridMs, 1e-6), differing > 0 ? "  (MISMATCH)" : "");
+        }
+    }
+
+    // ------------------------------------------------------------------
+    // Scene traversal: shared_ptr tree + dynamic_pointer_cast (former layout) vs kind tags
+    // on arena nodes vs the flat hierarchy with the mesh side table
+    // ------------------------------------------------------------------
+
+    // The node layout before the arena: own allocation, RTTI cast, refcounted links
+    struct LegacyNode : std::enable_shared_from_this<LegacyNode>
+    {
+        virtual ~LegacyNode() = default;
+        std::weak_ptr<LegacyNode> parent;
+        std::vector<std::shared_ptr<LegacyNode>> children;
+        glm::mat4 localTransform = glm::mat4(1.0f);
+        glm::mat4 globalTransform = glm::mat4(1.0f);
+    };
+
+    struct LegacyMeshNode : LegacyNode
+    {
+        MeshType mesh = MeshType::Cube;
+        Material material;
+    };
+
+    // Same work per mesh in every variant: read type, albedo and transform
+    struct TraversalSum
+    {
+        size_t meshes = 0;
+        float value = 0.0f;
+
+        void Add(MeshType type, const glm::vec3& albedo, const glm::mat4& model)
+        {
+            ++meshes;
+            value += static_cast<float>(type) + albedo.x + model[3].x;
+        }
+    };
+
+    void TraverseLegacy(const std::shared_ptr<LegacyNode>& node, TraversalSum& sum)
+    {
+        if (auto meshNode = std::dynamic_pointer_cast<LegacyMeshNode>(node))
+            sum.Add(meshNode->mesh, meshNode->material.albedo, meshNode->globalTransform);
+        for (auto& c : node->children)
+            TraverseLegacy(c, sum);
+    }
+
+    void TraverseTagged(const SceneNode* node, TraversalSum& sum)
+    {
+        if (const MeshNode* meshNode = NodeCast<MeshNode>(node))
+            sum.Add(meshNode->GetMeshType(), meshNode->GetMaterial().albedo, meshNode->GetGlobalTransform());
+        for (auto& c : node->children)
+            TraverseTagged(c.get(), sum);
+    }
+
+    void BenchSceneTraversal()
+    {
+        // root -> kGroups groups, each with kMeshesPerGroup meshes and one subgroup holding as many again
+        constexpr size_t kGroups = 5000;
+        constexpr size_t kMeshesPerGroup = 9;
+        constexpr int kPasses = 20;
+
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        auto randomMesh = [&]() { return static_cast<MeshType>(rng() % (static_cast<unsigned>(MeshType::Sphere) + 1)); };
+
+        auto legacyRoot = std::make_shared<LegacyNode>();
+        SceneNode::Ptr root = MakeNode<SceneNode>();
+        size_t nodeCount = 1;
+        auto addMeshes = [&](const std::shared_ptr<LegacyNode>& legacyParent, const SceneNode::Ptr& parent) {
+            for (size_t m = 0; m < kMeshesPerGroup; ++m)
+            {
+                const MeshType type = randomMesh();
+                const glm::vec3 albedo(unit(rng), unit(rng), unit(rng));
+                const glm::vec3 offset(unit(rng) * 10.0f, 0.0f, unit(rng) * 10.0f);
+
+                auto legacy = std::make_shared<LegacyMeshNode>();
+                legacy->mesh = type;
+                legacy->material.albedo = albedo;
+                legacy->localTransform[3] = glm::vec4(offset, 1.0f);
+                legacy->globalTransform = legacy->localTransform; // parents sit at the origin
+                legacy->parent = legacyParent;
+                legacyParent->children.push_back(legacy);
+
+                auto mesh = MakeNode<MeshNode>(type);
+                mesh->SetAlbedo(albedo);
+                glm::mat4 local(1.0f);
+                local[3] = glm::vec4(offset, 1.0f);
+                mesh->SetLocalTransform(local);
+                parent->AddChild(mesh);
+                ++nodeCount;
+            }
+        };
+        for (size_t g = 0; g < kGroups; ++g)
+        {
+            auto legacyGroup = std::make_shared<LegacyNode>();
+            auto legacySub = std::make_shared<LegacyNode>();
+            legacyGroup->parent = legacyRoot;
+            legacySub->parent = legacyGroup;
+            legacyRoot->children.push_back(legacyGroup);
+            legacyGroup->children.push_back(legacySub);
+
+            SceneNode::Ptr group = root->CreateChild();
+            SceneNode::Ptr sub = group->CreateChild();
+            nodeCount += 2;
+
+            addMeshes(legacyGroup, group);
+            addMeshes(legacySub, sub);
+        }
+        root->updateGlobalTransform();
+
+        TransformHierarchy hierarchy;
+        hierarchy.Build(root);
+        hierarchy.UpdateGlobalTransforms();
+
+        const double per100k = 100000.0 / static_cast<double>(nodeCount);
+        std::printf("\n[scene-traversal] %zu nodes, %zu meshes, %d passes\n", nodeCount, 2 * kGroups * kMeshesPerGroup, kPasses);
+        std::printf("%34s %16s %10s %10s\n", "traversal", "ms / 100k nodes", "speedup", "meshes");
+
+        auto run = [&](const char* name, double baseMs, auto&& traverse) {
+            TraversalSum sum;
+            const auto start = Clock::now();
+            for (int p = 0; p < kPasses; ++p)
+                traverse(sum);
+            const double ms = ElapsedMs(start) / kPasses * per100k;
+            g_sink = g_sink + sum.value;
+            std::printf("%34s %16.3f %9.2fx %10zu\n", name, ms, baseMs > 0.0 ? baseMs / std::max(ms, 1e-9) : 1.0,
+                        sum.meshes / kPasses);
+            return ms;
+        };
+
+        const double legacyMs = run("shared_ptr + dynamic_pointer_cast", 0.0, [&](TraversalSum& sum) {
+            TraverseLegacy(legacyRoot, sum);
+        });
+        run("arena nodes + kind tag", legacyMs, [&](TraversalSum& sum) {
+            TraverseTagged(root.get(), sum);
+        });
+        const MeshTable& meshTable = MeshTable::Get();
+        run("flat hierarchy + mesh table", legacyMs, [&](TraversalSum& sum) {
+            hierarchy.ForEachMesh(root.get(), [&](const glm::mat4& model, uint32_t meshId) {
+                sum.Add(meshTable.GetType(meshId), meshTable.GetMaterial(meshId).albedo, model);
+            });
+        });
+    }
+
+    // ------------------------------------------------------------------
+    // Transform update: mat4 locals/globals (former layout) vs TRS locals composed during the
+    // sweep with 3x4 affine globals, full-tree update including the bounds refit
+    // ------------------------------------------------------------------
+
+    void BenchTransformUpdate()
+    {
+        // root -> kGroups groups of kMeshesPerGroup meshes
+        constexpr size_t kGroups = 10000;
+        constexpr size_t kMeshesPerGroup = 9;
+        constexpr int kPasses = 50;
+
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        auto randomTRS = [&](float spread) {
+            const glm::vec3 axis = glm::normalize(glm::vec3(unit(rng), unit(rng), unit(rng)) + glm::vec3(0.1f));
+            return TRS{ glm::vec3(unit(rng), unit(rng), unit(rng)) * spread, glm::angleAxis(unit(rng) * 6.28f, axis),
+                        glm::vec3(0.5f + unit(rng)) };
+        };
+
+        SceneNode::Ptr root = MakeNode<SceneNode>();
+        for (size_t g = 0; g < kGroups; ++g)
+        {
+            SceneNode::Ptr group = root->CreateChild();
+            const TRS gt = randomTRS(100.0f);
+            group->SetLocalTRS(gt.position, gt.rotation, gt.scale);
+            for (size_t m = 0; m < kMeshesPerGroup; ++m)
+            {
+                auto mesh = MakeNode<MeshNode>(MeshType::Cube);
+                const TRS mt = randomTRS(5.0f);
+                mesh->SetLocalTRS(mt.position, mt.rotation, mt.scale);
+                group->AddChild(mesh);
+            }
+        }
+
+        TransformHierarchy hierarchy;
+        hierarchy.Build(root);
+        hierarchy.UpdateGlobalTransforms();
+
+        // The former arrays in the same depth-first order
+        const size_t count = hierarchy.Size();
+        const std::vector<int32_t>& parents = hierarchy.GetParents();
+        std::vector<glm::mat4> locals(count), globals(count);
+        std::vector<uint8_t> hasBounds(count);
+        std::vector<AABB> worldBounds(count), subtreeBounds(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            locals[i] = hierarchy.GetNodes()[i]->GetLocalTransform();
+            hasBounds[i] = hierarchy.GetMeshIds()[i] != MeshTable::kNoMesh;
+        }
+        const AABB unitBox{ glm::vec3(-0.5f), glm::vec3(0.5f) };
+
+        const double per100k = 100000.0 / static_cast<double>(count);
+        std::printf("\n[transform-update] %zu nodes, %d full updates\n", count, kPasses);
+        std::printf("%26s %16s %10s %12s\n", "layout", "ms / 100k nodes", "speedup", "bytes/node");
+
+        // Rotating the root dirties the whole tree in both variants
+        const auto matStart = Clock::now();
+        for (int p = 0; p < kPasses; ++p)
+        {
+            const TRS spin{ glm::vec3(0.0f), glm::angleAxis(0.01f * static_cast<float>(p + 1), glm::vec3(0.0f, 1.0f, 0.0f)) };
+            locals[0] = ComposeTRS(spin).ToMat4();
+            for (size_t i = 0; i < count; ++i)
+            {
+                const int32_t parent = parents[i];
+                globals[i] = (parent < 0) ? locals[i] : globals[parent] * locals[i];
+                worldBounds[i] = hasBounds[i] ? TransformAABB(unitBox, globals[i]) : EmptyAABB();
+                subtreeBounds[i] = worldBounds[i];
+            }
+            for (size_t i = count; i-- > 1;)
+                MergeAABB(subtreeBounds[parents[i]], subtreeBounds[i]);
+        }
+        const double matMs = ElapsedMs(matStart) / kPasses * per100k;
+        g_sink = g_sink + globals[count - 1][3].x + subtreeBounds[0].max.x;
+
+        const auto trsStart = Clock::now();
+        for (int p = 0; p < kPasses; ++p)
+        {
+            root->SetLocalRotation(glm::angleAxis(0.01f * static_cast<float>(p + 1), glm::vec3(0.0f, 1.0f, 0.0f)));
+            hierarchy.UpdateGlobalTransforms();
+        }
+        const double trsMs = ElapsedMs(trsStart) / kPasses * per100k;
+        g_sink = g_sink + hierarchy.GetSubtreeBounds()[0].max.x;
+
+        // Largest difference between the two results, to show they agree
+        float maxError = 0.0f;
+        for (size_t i = 0; i < count; ++i)
+        {
+            const glm::mat4 trsGlobal = hierarchy.GetGlobalTransforms()[i].ToMat4();
+            for (int c = 0; c < 4; ++c)
+                for (int r = 0; r < 3; ++r)
+                    maxError = std::max(maxError, std::abs(trsGlobal[c][r] - globals[i][c][r]));
+        }
+
+        std::printf("%26s %16.3f %9.2fx %12zu\n", "mat4 local + mat4 global", matMs, 1.0, 2 * sizeof(glm::mat4));
+        std::printf("%26s %16.3f %9.2fx %12zu\n", "TRS local + 3x4 global", trsMs, matMs / std::max(trsMs, 1e-9),
+                    sizeof(TRS) + sizeof(Affine3x4));
+        std::printf("  max |difference| %.2e\n", maxError);
+    }
+
+    struct Benchmark
+    {
+        const char* name;
+        std::function<void()> run;
+    };
+
+    const std::vector<Benchmark>& Benchmarks()
+    {
+        static const std::vector<Benchmark> benchmarks = {
+            { "collision", BenchCollision },
+            { "raycast", BenchRaycast },
+            { "particles", BenchParticles },
+            { "rng", BenchRandom },
+            { "jobs", BenchJobs },
+            { "particle-collision", BenchParticleCollision },
+            { "scene-traversal", BenchSceneTraversal },
+            { "transform-update", BenchTransformUpdate },
+        };
+        return benchmarks;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool ranAny = false;
+    for (const Benchmark& b : Benchmarks())
+    {
+        bool selected = (argc < 2);
+        for (int i = 1; i < argc; ++i)
+        {
+            if (std::strcmp(argv[i], b.name) == 0) selected = true;
+        }
+        if (!selected) continue;
+
+        b.run();
+        ranAny = true;
+    }
+
+    if (!ranAny)
+    {
+        std::printf("Unknown benchmark. Available:");
+        for (const Benchmark& b : Benchmarks()) std::printf(" %s", b.name);
+        std::printf("\n");
+        return 1;
+    }
+    return 0;
+}
@@ -1,8 +1,7 @@
 #version 330 core
+in vec4 vColor;
 out vec4 FragColor;
 
-uniform vec4 particleColor;
-
 void main()
 {
     // Circular particle
@@ -10,5 +9,5 @@ void main()
     if (dot(circCoord, circCoord) > 1.0) {
         discard;
     }
-    FragColor = particleColor;
+    FragColor = vColor;
 }
@@ -1,12 +1,17 @@
 #version 330 core
-layout (location = 0) in vec3 aPos;
+layout (location = 0) in vec4 aPositionSize; // xyz relative to particleOrigin, w = point size (pixels)
+layout (location = 1) in vec4 aColor;
 
 uniform mat4 projection;
 uniform mat4 view;
 uniform mat4 model;
+uniform vec3 particleOrigin;
+
+out vec4 vColor;
 
 void main()
 {
-    gl_Position = projection * view * model * vec4(aPos, 1.0);
-    gl_PointSize = 10.0; // Size of particle
+    gl_Position = projection * view * model * vec4(aPositionSize.xyz + particleOrigin, 1.0);
+    gl_PointSize = aPositionSize.w;
+    vColor = aColor;
 }
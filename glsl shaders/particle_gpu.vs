@@ -0,0 +1,27 @@
+#version 430 core
+// Draws straight from the compute simulation's particle buffer (see particle_sim.comp)
+layout (location = 0) in vec4 aPositionLife;
+layout (location = 1) in float aAlpha;
+
+uniform mat4 projection;
+uniform mat4 view;
+uniform mat4 model;
+uniform vec3 particleColor;
+
+out vec4 vColor;
+
+void main()
+{
+    if (aPositionLife.w <= 0.0)
+    {
+        // Dead slot: place it outside the clip volume so the point is dropped
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        gl_PointSize = 1.0;
+        vColor = vec4(0.0);
+        return;
+    }
+
+    gl_Position = projection * view * model * vec4(aPositionLife.xyz, 1.0);
+    gl_PointSize = 10.0; // Size of particle
+    vColor = vec4(particleColor, clamp(aAlpha, 0.0, 1.0));
+}
@@ -4,20 +4,30 @@ layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoord;
 
+// Per-instance attributes (only read when useInstancing is true)
+layout(location = 3) in mat4 aInstanceModel;
+layout(location = 7) in vec3 aInstanceAlbedo;
+
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
+uniform vec3 albedo;
+uniform bool useInstancing;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
+out vec3 Albedo;
 
 void main()
 {
-    vec4 worldPos = model * vec4(aPos, 1.0);
+    mat4 modelMatrix = useInstancing ? aInstanceModel : model;
+    Albedo = useInstancing ? aInstanceAlbedo : albedo;
+
+    vec4 worldPos = modelMatrix * vec4(aPos, 1.0);
     FragPos = worldPos.xyz;
     // Correct normal transform for non-uniform scale
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    Normal = mat3(transpose(inverse(modelMatrix))) * aNormal;
     TexCoords = aTexCoord;
     gl_Position = projection * view * worldPos;
-}
\ No newline at end of file
+}
@@ -3,6 +3,7 @@
 // Inputs (from vertex shader) - world-space
 in vec3 FragPos;
 in vec3 Normal;
+in vec3 Albedo; // per-instance or uniform albedo, resolved in scene.vs
 
 // Output
 out vec4 FragColor;
@@ -17,12 +18,13 @@ struct DirectionalLight
     float intensity;
 };
 
-// Point light structure
+// Point light structure (std140: 32 bytes, mirrors PointLight in LightManager.h)
 struct PointLight
 {
     vec3 position;
-    vec3 color;
     float intensity;
+    vec3 color;
+    float radius; // influence ends here (smooth falloff to zero)
 };
 
 // Sun object model matrix (world transform). The sun is expected to orbit the scene center:
@@ -47,14 +49,36 @@ uniform vec3 moonLightDirection;
 uniform vec3 moonLightColor;
 uniform float moonLightIntensity;
 
-// Simple material / ambient parameters for demonstration
+// Simple ambient parameter for demonstration
 uniform vec3 ambientColor;
-uniform vec3 albedo;
 
-// Point lights (streetlights)
+// Point lights (streetlights), uploaded by LightManager.
+// MAX_POINT_LIGHTS is normally injected from GL_MAX_UNIFORM_BLOCK_SIZE at load time.
+#ifndef MAX_POINT_LIGHTS
 #define MAX_POINT_LIGHTS 100
-uniform int numPointLights;
-uniform PointLight pointLights[MAX_POINT_LIGHTS];
+#endif
+layout(std140) uniform PointLightBlock
+{
+    int numPointLights;
+    float pointLightScale; // global switch * brightness
+    PointLight pointLights[MAX_POINT_LIGHTS];
+};
+
+// Clustered lighting (LightClusterer): the fragment's cluster lists the lights to evaluate.
+// Grid dimensions are injected at load time to match LightClusterer::kGridX/Y/Z.
+#ifndef CLUSTER_GRID_X
+#define CLUSTER_GRID_X 16
+#define CLUSTER_GRID_Y 9
+#define CLUSTER_GRID_Z 24
+#endif
+uniform bool useClusteredLighting;
+uniform mat4 view;
+uniform vec2 clusterScreenSize;          // framebuffer size in pixels
+uniform float clusterSliceScale;         // slice = log(viewDepth) * scale + bias
+uniform float clusterSliceBias;
+uniform samplerBuffer pointLightData;    // 2 texels per light: (position, intensity), (color, radius)
+uniform usamplerBuffer clusterGrid;      // per cluster: (offset, count)
+uniform usamplerBuffer clusterLightIndices;
 
 // Build a DirectionalLight from the sun's model matrix by computing the sun world position
 // and deriving the light direction from sun -> sceneCenter.
@@ -92,7 +116,11 @@ vec3 CalculatePointLight(PointLight light, vec3 fragPos, vec3 normal, vec3 albed
     lightDir = normalize(lightDir);
     
     // Stronger attenuation for more localized lighting (increased quadratic term)
-    float attenuation = light.intensity / (1.0 + 0.2 * distance + 0.15 * distance * distance);
+    float attenuation = light.intensity * pointLightScale / (1.0 + 0.2 * distance + 0.15 * distance * distance);
+
+    // Window the tail so the light reaches exactly zero at its radius (matches the cluster bounds)
+    float falloff = clamp(1.0 - pow(distance / max(light.radius, 1e-4), 4.0), 0.0, 1.0);
+    attenuation *= falloff * falloff;
     
     // Diffuse
     float diff = max(dot(normal, lightDir), 0.0);
@@ -106,6 +134,7 @@ void main()
 {
     // Normalize interpolated normal
     vec3 N = normalize(Normal);
+    vec3 albedo = Albedo;
 
     // Create the directional light based on the sun transform
     DirectionalLight sun = CreateDirectionalLightFromSun(sunModel, sceneCenter);
@@ -127,9 +156,35 @@ void main()
     color += CalculateDirectionalLight(moonLightDirection, moonLightColor, moonLightIntensity, N, albedo);
     
     // Add point light contributions (streetlights)
-    for (int i = 0; i < numPointLights && i < MAX_POINT_LIGHTS; ++i)
+    if (useClusteredLighting)
+    {
+        float viewDepth = -(view * vec4(FragPos, 1.0)).z;
+        ivec2 tile = ivec2(gl_FragCoord.xy / clusterScreenSize * vec2(CLUSTER_GRID_X, CLUSTER_GRID_Y));
+        int slice = int(floor(log(max(viewDepth, 1e-4)) * clusterSliceScale + clusterSliceBias));
+        tile = clamp(tile, ivec2(0), ivec2(CLUSTER_GRID_X - 1, CLUSTER_GRID_Y - 1));
+        slice = clamp(slice, 0, CLUSTER_GRID_Z - 1);
+
+        uvec2 cluster = texelFetch(clusterGrid, (slice * CLUSTER_GRID_Y + tile.y) * CLUSTER_GRID_X + tile.x).xy;
+        for (uint i = 0u; i < cluster.y; ++i)
+        {
+            int lightIndex = int(texelFetch(clusterLightIndices, int(cluster.x + i)).x);
+            vec4 positionIntensity = texelFetch(pointLightData, lightIndex * 2);
+            vec4 colorRadius = texelFetch(pointLightData, lightIndex * 2 + 1);
+
+            PointLight light;
+            light.position = positionIntensity.xyz;
+            light.intensity = positionIntensity.w;
+            light.color = colorRadius.xyz;
+            light.radius = colorRadius.w;
+            color += CalculatePointLight(light, FragPos, N, albedo);
+        }
+    }
+    else
     {
-        color += CalculatePointLight(pointLights[i], FragPos, N, albedo);
+        for (int i = 0; i < numPointLights && i < MAX_POINT_LIGHTS; ++i)
+        {
+            color += CalculatePointLight(pointLights[i], FragPos, N, albedo);
+        }
     }
 
     FragColor = vec4(color, 1.0);
@@ -0,0 +1,170 @@
+#include "BVH.h"
+
+#include <algorithm>
+
+void BVH::Clear()
+{
+    nodes.clear();
+    items.clear();
+    centroids.clear();
+}
+
+void BVH::Build(const std::vector<AABB>& boxes)
+{
+    Clear();
+    if (boxes.empty()) return;
+
+    const uint32_t count = static_cast<uint32_t>(boxes.size());
+    items.resize(count);
+    centroids.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        items[i] = i;
+        centroids[i] = (boxes[i].min + boxes[i].max) * 0.5f;
+    }
+
+    // A binary tree with n leaves has at most 2n - 1 nodes
+    nodes.reserve(static_cast<size_t>(count) * 2);
+    Node root;
+    root.first = 0;
+    root.count = count;
+    nodes.push_back(root);
+    Subdivide(0, boxes, 0);
+
+    centroids.clear();
+    centroids.shrink_to_fit();
+}
+
+void BVH::Subdivide(uint32_t nodeIndex, const std::vector<AABB>& boxes, int depth)
+{
+    // Bounds of the node and of its item centroids
+    glm::vec3 bmin(FLT_MAX), bmax(-FLT_MAX);
+    glm::vec3 cmin(FLT_MAX), cmax(-FLT_MAX);
+    {
+        const Node& node = nodes[nodeIndex];
+        for (uint32_t i = node.first; i < node.first + node.count; ++i)
+        {
+            const uint32_t item = items[i];
+            bmin = glm::min(bmin, boxes[item].min);
+            bmax = glm::max(bmax, boxes[item].max);
+            cmin = glm::min(cmin, centroids[item]);
+            cmax = glm::max(cmax, centroids[item]);
+        }
+        nodes[nodeIndex].min = bmin;
+        nodes[nodeIndex].max = bmax;
+    }
+
+    const uint32_t first = nodes[nodeIndex].first;
+    const uint32_t count = nodes[nodeIndex].count;
+    if (count <= kMaxLeafSize || depth >= kMaxDepth - 1) return;
+
+    // Binned SAH: pick the axis/bin boundary with the lowest area * count cost
+    auto halfArea = [](const glm::vec3& lo, const glm::vec3& hi) {
+        const glm::vec3 e = glm::max(hi - lo, glm::vec3(0.0f));
+        return e.x * e.y + e.y * e.z + e.z * e.x;
+    };
+
+    float bestCost = FLT_MAX;
+    int bestAxis = -1;
+    float bestSplit = 0.0f;
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const float extent = cmax[axis] - cmin[axis];
+        if (extent <= 1e-6f) continue;
+
+        struct Bin { glm::vec3 min{ FLT_MAX }, max{ -FLT_MAX }; uint32_t count = 0; };
+        Bin bins[kBins];
+        const float scale = static_cast<float>(kBins) / extent;
+        for (uint32_t i = first; i < first + count; ++i)
+        {
+            const uint32_t item = items[i];
+            const int b = std::min(kBins - 1, static_cast<int>((centroids[item][axis] - cmin[axis]) * scale));
+            bins[b].count++;
+            bins[b].min = glm::min(bins[b].min, boxes[item].min);
+            bins[b].max = glm::max(bins[b].max, boxes[item].max);
+        }
+
+        // Sweep from both sides to get the cost of every boundary
+        float leftArea[kBins - 1], rightArea[kBins - 1];
+        uint32_t leftCount[kBins - 1], rightCount[kBins - 1];
+        glm::vec3 lmin(FLT_MAX), lmax(-FLT_MAX), rmin(FLT_MAX), rmax(-FLT_MAX);
+        uint32_t lsum = 0, rsum = 0;
+        for (int i = 0; i < kBins - 1; ++i)
+        {
+            lsum += bins[i].count;
+            lmin = glm::min(lmin, bins[i].min);
+            lmax = glm::max(lmax, bins[i].max);
+            leftCount[i] = lsum;
+            leftArea[i] = halfArea(lmin, lmax);
+
+            const int j = kBins - 1 - i;
+            rsum += bins[j].count;
+            rmin = glm::min(rmin, bins[j].min);
+            rmax = glm::max(rmax, bins[j].max);
+            rightCount[j - 1] = rsum;
+            rightArea[j - 1] = halfArea(rmin, rmax);
+        }
+
+        for (int i = 0; i < kBins - 1; ++i)
+        {
+            if (leftCount[i] == 0 || rightCount[i] == 0) continue;
+            const float cost = leftCount[i] * leftArea[i] + rightCount[i] * rightArea[i];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = cmin[axis] + static_cast<float>(i + 1) / scale;
+            }
+        }
+    }
+
+    uint32_t mid = first;
+    if (bestAxis >= 0)
+    {
+        // Splitting must beat keeping one leaf (cost = count * area), unless the leaf would be large
+        const float leafCost = count * halfArea(bmin, bmax);
+        if (bestCost >= leafCost && count <= kMaxLeafSize * 4) return;
+
+        auto it = std::partition(items.begin() + first, items.begin() + first + count,
+                                 [&](uint32_t item) { return centroids[item][bestAxis] < bestSplit; });
+        mid = static_cast<uint32_t>(it - items.begin());
+    }
+
+    if (mid == first || mid == first + count)
+    {
+        // All centroids coincide (or the SAH split degenerated): median split on the longest axis
+        const glm::vec3 e = cmax - cmin;
+        const int axis = (e.x > e.y && e.x > e.z) ? 0 : (e.y > e.z ? 1 : 2);
+        mid = first + count / 2;
+        std::nth_element(items.begin() + first, items.begin() + mid, items.begin() + first + count,
+                         [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+    }
+
+    const uint32_t leftIndex = static_cast<uint32_t>(nodes.size());
+    Node left, right;
+    left.first = first;
+    left.count = mid - first;
+    right.first = mid;
+    right.count = first + count - mid;
+    nodes.push_back(left);
+    nodes.push_back(right);
+
+    nodes[nodeIndex].first = leftIndex;
+    nodes[nodeIndex].count = 0;
+
+    Subdivide(leftIndex, boxes, depth + 1);
+    Subdivide(leftIndex + 1, boxes, depth + 1);
+}
+
+float BVH::IntersectNode(const Node& node, const glm::vec3& origin, const glm::vec3& invDir, float tMax)
+{
+    const glm::vec3 t0 = (node.min - origin) * invDir;
+    const glm::vec3 t1 = (node.max - origin) * invDir;
+    const glm::vec3 tmin = glm::min(t0, t1);
+    const glm::vec3 tmax = glm::max(t0, t1);
+
+    const float tNear = std::max(std::max(tmin.x, tmin.y), std::max(tmin.z, 0.0f));
+    const float tFar = std::min(std::min(tmax.x, tmax.y), std::min(tmax.z, tMax));
+    return tNear <= tFar ? tNear : FLT_MAX;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "Collision.h"
+
+// Bounding volume hierarchy over a list of AABBs (binned SAH build).
+// Nodes are stored flat; an interior node's children are nodes[first] and nodes[first + 1],
+// a leaf references items[first .. first + count) (indices into the boxes given to Build).
+// What an item is (mesh, collider, ...) is up to the caller: Raycast hands leaf items to a
+// callback that does the exact intersection.
+class BVH
+{
+public:
+    struct Node
+    {
+        glm::vec3 min;
+        uint32_t first = 0; // left child (interior) or first item (leaf)
+        glm::vec3 max;
+        uint32_t count = 0; // 0 for interior nodes
+    };
+
+    void Build(const std::vector<AABB>& boxes);
+    void Clear();
+
+    // Walks the nodes hit by the ray (near child first) and calls
+    // leafTest(uint32_t item, float& tMax) for each candidate item. leafTest shrinks tMax when it
+    // finds a closer hit, which prunes the rest of the traversal. dir does not need to be normalized;
+    // distances are in units of dir.
+    template <typename LeafTest>
+    void Raycast(const glm::vec3& origin, const glm::vec3& dir, float& tMax, LeafTest&& leafTest) const;
+
+    bool Empty() const { return nodes.empty(); }
+    size_t GetNodeCount() const { return nodes.size(); }
+    size_t GetItemCount() const { return items.size(); }
+
+private:
+    static constexpr uint32_t kMaxLeafSize = 4;
+    static constexpr int kBins = 12;
+    static constexpr int kMaxDepth = 64;
+
+    void Subdivide(uint32_t nodeIndex, const std::vector<AABB>& boxes, int depth);
+
+    // Entry distance of the ray into a node (FLT_MAX if missed or beyond tMax)
+    static float IntersectNode(const Node& node, const glm::vec3& origin, const glm::vec3& invDir, float tMax);
+
+    std::vector<Node> nodes;
+    std::vector<uint32_t> items;
+    std::vector<glm::vec3> centroids; // build scratch
+};
+
+template <typename LeafTest>
+void BVH::Raycast(const glm::vec3& origin, const glm::vec3& dir, float& tMax, LeafTest&& leafTest) const
+{
+    if (nodes.empty()) return;
+
+    const glm::vec3 invDir = 1.0f / dir;
+    if (IntersectNode(nodes[0], origin, invDir, tMax) == FLT_MAX) return;
+
+    uint32_t stack[kMaxDepth * 2];
+    int top = 0;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        const Node& node = nodes[stack[--top]];
+
+        if (node.count > 0)
+        {
+            for (uint32_t i = 0; i < node.count; ++i)
+                leafTest(items[node.first + i], tMax);
+            continue;
+        }
+
+        // Visit the nearer child first so its hits shrink tMax before the far one is tested
+        uint32_t nearChild = node.first;
+        uint32_t farChild = node.first + 1;
+        float tNear = IntersectNode(nodes[nearChild], origin, invDir, tMax);
+        float tFar = IntersectNode(nodes[farChild], origin, invDir, tMax);
+        if (tFar < tNear)
+        {
+            std::swap(nearChild, farChild);
+            std::swap(tNear, tFar);
+        }
+
+        if (tFar != FLT_MAX) stack[top++] = farChild;
+        if (tNear != FLT_MAX) stack[top++] = nearChild;
+    }
+}
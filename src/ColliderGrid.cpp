@@ -0,0 +1,89 @@
+#include "ColliderGrid.h"
+
+#include <cmath>
+
+void ColliderGrid::Build(const std::vector<AABB>& newBoxes, float newCellSize)
+{
+    boxes = newBoxes;
+    cellSize = std::max(newCellSize, 0.01f);
+    invCellSize = 1.0f / cellSize;
+
+    cellStart.clear();
+    cellItems.clear();
+    oversized.clear();
+    stamps.assign(boxes.size(), 0u);
+    queryStamp = 0;
+    cellsX = cellsZ = 0;
+    if (boxes.empty()) return;
+
+    // Grid covers the XZ bounds of all boxes
+    glm::vec2 lo(FLT_MAX), hi(-FLT_MAX);
+    for (const AABB& b : boxes)
+    {
+        lo = glm::min(lo, glm::vec2(b.min.x, b.min.z));
+        hi = glm::max(hi, glm::vec2(b.max.x, b.max.z));
+    }
+    origin = lo;
+    cellsX = std::max(1, static_cast<int>(std::ceil((hi.x - lo.x) * invCellSize)));
+    cellsZ = std::max(1, static_cast<int>(std::ceil((hi.y - lo.y) * invCellSize)));
+    const size_t cellCount = static_cast<size_t>(cellsX) * static_cast<size_t>(cellsZ);
+
+    // Pass 1: count entries per cell (counts stored shifted by one for the prefix sum)
+    std::vector<uint8_t> inGrid(boxes.size(), 0);
+    cellStart.assign(cellCount + 1, 0u);
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        const AABB& b = boxes[i];
+        const int x0 = CellX(b.min.x), x1 = CellX(b.max.x);
+        const int z0 = CellZ(b.min.z), z1 = CellZ(b.max.z);
+        const uint32_t covered = static_cast<uint32_t>((x1 - x0 + 1) * (z1 - z0 + 1));
+        if (covered > kMaxCellsPerBox)
+        {
+            oversized.push_back(static_cast<uint32_t>(i));
+            continue;
+        }
+
+        inGrid[i] = 1;
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                ++cellStart[static_cast<size_t>(z * cellsX + x) + 1];
+    }
+
+    for (size_t c = 0; c < cellCount; ++c)
+        cellStart[c + 1] += cellStart[c];
+
+    // Pass 2: scatter box indices
+    cellItems.resize(cellStart[cellCount]);
+    std::vector<uint32_t> cursor(cellStart.begin(), cellStart.end() - 1);
+    for (size_t i = 0; i < boxes.size(); ++i)
+    {
+        if (!inGrid[i]) continue;
+
+        const AABB& b = boxes[i];
+        const int x0 = CellX(b.min.x), x1 = CellX(b.max.x);
+        const int z0 = CellZ(b.min.z), z1 = CellZ(b.max.z);
+        for (int z = z0; z <= z1; ++z)
+            for (int x = x0; x <= x1; ++x)
+                cellItems[cursor[static_cast<size_t>(z * cellsX + x)]++] = static_cast<uint32_t>(i);
+    }
+}
+
+bool ColliderGrid::AnyOverlap(const AABB& region) const
+{
+    bool hit = false;
+    ForEachCandidate(glm::vec2(region.min.x, region.min.z), glm::vec2(region.max.x, region.max.z),
+                     [&](const AABB& box) { if (!hit && region.Overlaps(box)) hit = true; });
+    return hit;
+}
+
+int ColliderGrid::CellX(float x) const
+{
+    const int c = static_cast<int>(std::floor((x - origin.x) * invCellSize));
+    return std::clamp(c, 0, cellsX - 1);
+}
+
+int ColliderGrid::CellZ(float z) const
+{
+    const int c = static_cast<int>(std::floor((z - origin.y) * invCellSize));
+    return std::clamp(c, 0, cellsZ - 1);
+}
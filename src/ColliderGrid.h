@@ -0,0 +1,108 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Collision.h"
+
+// Static broadphase for world colliders: a uniform grid over the XZ plane.
+// Each box is registered in every cell its XZ footprint touches (cell lists are stored
+// contiguously, CSR style); boxes covering very many cells (ground planes, big floors)
+// go to a small "oversized" list that every query checks instead.
+// Built once from CollectColliders' output; query cost is proportional to the nearby boxes.
+class ColliderGrid
+{
+public:
+    ColliderGrid() = default;
+
+    // Rebuilds the grid from boxes. cellSize is the XZ edge length of a cell in world units.
+    void Build(const std::vector<AABB>& boxes, float cellSize = 4.0f);
+
+    // Calls fn(const AABB&) once for every box whose XZ footprint may overlap [min, max]
+    // (y is ignored by the broadphase). Boxes spanning several cells are reported once.
+    template <typename Fn>
+    void ForEachCandidate(const glm::vec2& minXZ, const glm::vec2& maxXZ, Fn&& fn) const;
+
+    // Calls fn(const AABB&) for every box registered in the cell containing xz (plus the oversized
+    // boxes). A point lies in exactly one cell, so no dedupe is needed: unlike ForEachCandidate this
+    // touches no mutable state and may be called from several threads at once.
+    template <typename Fn>
+    void ForEachAtPoint(const glm::vec2& xz, Fn&& fn) const;
+
+    // True if any box overlaps region (exact AABB test on the candidates).
+    bool AnyOverlap(const AABB& region) const;
+
+    const std::vector<AABB>& GetBoxes() const { return boxes; }
+    size_t Size() const { return boxes.size(); }
+    bool Empty() const { return boxes.empty(); }
+
+private:
+    // Boxes touching more cells than this are kept out of the grid
+    static constexpr uint32_t kMaxCellsPerBox = 64;
+
+    int CellX(float x) const;
+    int CellZ(float z) const;
+
+    std::vector<AABB> boxes;
+    std::vector<uint32_t> cellStart;  // cells + 1 entries; items of cell c are [cellStart[c], cellStart[c+1])
+    std::vector<uint32_t> cellItems;  // box indices
+    std::vector<uint32_t> oversized;  // box indices tested by every query
+
+    glm::vec2 origin = glm::vec2(0.0f);
+    float cellSize = 4.0f;
+    float invCellSize = 0.25f;
+    int cellsX = 0;
+    int cellsZ = 0;
+
+    // Per-box query stamp so a box found in several cells is only reported once
+    mutable std::vector<uint32_t> stamps;
+    mutable uint32_t queryStamp = 0;
+};
+
+template <typename Fn>
+void ColliderGrid::ForEachCandidate(const glm::vec2& minXZ, const glm::vec2& maxXZ, Fn&& fn) const
+{
+    for (uint32_t i : oversized)
+        fn(boxes[i]);
+
+    if (cellsX == 0 || cellsZ == 0) return;
+
+    if (++queryStamp == 0)
+    {
+        // Wrapped around: clear stale stamps
+        std::fill(stamps.begin(), stamps.end(), 0u);
+        queryStamp = 1;
+    }
+
+    const int x0 = CellX(minXZ.x), x1 = CellX(maxXZ.x);
+    const int z0 = CellZ(minXZ.y), z1 = CellZ(maxXZ.y);
+    for (int z = z0; z <= z1; ++z)
+    {
+        for (int x = x0; x <= x1; ++x)
+        {
+            const uint32_t cell = static_cast<uint32_t>(z * cellsX + x);
+            for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k)
+            {
+                const uint32_t i = cellItems[k];
+                if (stamps[i] == queryStamp) continue;
+                stamps[i] = queryStamp;
+                fn(boxes[i]);
+            }
+        }
+    }
+}
+
+template <typename Fn>
+void ColliderGrid::ForEachAtPoint(const glm::vec2& xz, Fn&& fn) const
+{
+    for (uint32_t i : oversized)
+        fn(boxes[i]);
+
+    if (cellsX == 0 || cellsZ == 0) return;
+
+    const uint32_t cell = static_cast<uint32_t>(CellZ(xz.y) * cellsX + CellX(xz.x));
+    for (uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; ++k)
+        fn(boxes[cellItems[k]]);
+}
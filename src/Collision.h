@@ -42,3 +42,23 @@ inline AABB GetAABBFromTransform(const glm::mat4& transform) {
 
     return box;
 }
+
+// Empty box (min > max): merging anything into it yields that thing
+inline AABB EmptyAABB() {
+    return AABB{ glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX) };
+}
+
+inline void MergeAABB(AABB& box, const AABB& other) {
+    box.min = glm::min(box.min, other.min);
+    box.max = glm::max(box.max, other.max);
+}
+
+// World AABB of a local box under an affine transform: |M| * half-size around the transformed center
+inline AABB TransformAABB(const AABB& local, const glm::mat4& m) {
+    const glm::vec3 center = glm::vec3(m * glm::vec4((local.min + local.max) * 0.5f, 1.0f));
+    const glm::vec3 half = (local.max - local.min) * 0.5f;
+    glm::vec3 extent(0.0f);
+    for (int axis = 0; axis < 3; ++axis)
+        extent += glm::abs(glm::vec3(m[axis])) * half[axis];
+    return AABB{ center - extent, center + extent };
+}
@@ -0,0 +1,23 @@
+#include "CollisionWorld.h"
+
+void CollisionWorld::SetStatic(const std::vector<AABB>& boxes, float cellSize)
+{
+    staticLayer.Build(boxes, cellSize);
+}
+
+CollisionWorld::DynamicHandle CollisionWorld::AddDynamic(const AABB& box, bool enabled)
+{
+    dynamicLayer.push_back({ box, enabled });
+    return static_cast<DynamicHandle>(dynamicLayer.size() - 1);
+}
+
+bool CollisionWorld::Overlaps(const AABB& region) const
+{
+    if (staticLayer.AnyOverlap(region)) return true;
+
+    for (const DynamicCollider& d : dynamicLayer)
+    {
+        if (d.enabled && region.Overlaps(d.box)) return true;
+    }
+    return false;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Collision.h"
+#include "ColliderGrid.h"
+
+// Layered collision world queried by Player:
+// - static layer: immutable world geometry, indexed once in a ColliderGrid
+// - dynamic layer: a few persistent slots (doors, gate) whose box and enabled state are
+//   updated in place every frame
+// Nothing is copied or allocated per frame; queries only visit nearby static boxes
+// plus the (small) enabled dynamic set.
+class CollisionWorld
+{
+public:
+    using DynamicHandle = uint32_t;
+
+    // Replaces the static layer.
+    void SetStatic(const std::vector<AABB>& boxes, float cellSize = 4.0f);
+
+    // Registers a dynamic collider slot; the handle stays valid for the world's lifetime.
+    DynamicHandle AddDynamic(const AABB& box, bool enabled = true);
+    void SetDynamic(DynamicHandle handle, const AABB& box) { dynamicLayer[handle].box = box; }
+    void SetDynamicEnabled(DynamicHandle handle, bool enabled) { dynamicLayer[handle].enabled = enabled; }
+
+    // True if region overlaps any static box or enabled dynamic box.
+    bool Overlaps(const AABB& region) const;
+
+    // Calls fn(const AABB&) for every box that may overlap the XZ rectangle [minXZ, maxXZ]
+    // (static candidates from the grid, then every enabled dynamic box).
+    template <typename Fn>
+    void ForEachCandidate(const glm::vec2& minXZ, const glm::vec2& maxXZ, Fn&& fn) const
+    {
+        staticLayer.ForEachCandidate(minXZ, maxXZ, fn);
+        for (const DynamicCollider& d : dynamicLayer)
+        {
+            if (d.enabled) fn(d.box);
+        }
+    }
+
+    const ColliderGrid& GetStaticLayer() const { return staticLayer; }
+    size_t GetStaticCount() const { return staticLayer.Size(); }
+    size_t GetDynamicCount() const { return dynamicLayer.size(); }
+
+private:
+    struct DynamicCollider
+    {
+        AABB box;
+        bool enabled = true;
+    };
+
+    ColliderGrid staticLayer;
+    std::vector<DynamicCollider> dynamicLayer;
+};
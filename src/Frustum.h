@@ -0,0 +1,44 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Collision.h"
+
+// View frustum as six inward-facing planes (a point p is inside when dot(n, p) + d >= 0 for
+// all of them), extracted from a view-projection matrix (Gribb & Hartmann).
+struct Frustum {
+    enum class Result { Outside, Intersects, Inside };
+
+    glm::vec4 planes[6]; // xyz = normal, w = d
+
+    Frustum() = default;
+
+    explicit Frustum(const glm::mat4& viewProjection) {
+        const glm::mat4 m = glm::transpose(viewProjection); // rows of the matrix as columns
+        planes[0] = m[3] + m[0]; // left
+        planes[1] = m[3] - m[0]; // right
+        planes[2] = m[3] + m[1]; // bottom
+        planes[3] = m[3] - m[1]; // top
+        planes[4] = m[3] + m[2]; // near
+        planes[5] = m[3] - m[2]; // far
+        for (glm::vec4& p : planes)
+            p /= glm::length(glm::vec3(p));
+    }
+
+    // Conservative box test: Outside is exact for the planes, Intersects may include boxes
+    // that are outside near a frustum corner.
+    Result Classify(const AABB& box) const {
+        const glm::vec3 center = (box.min + box.max) * 0.5f;
+        const glm::vec3 half = (box.max - box.min) * 0.5f;
+
+        Result result = Result::Inside;
+        for (const glm::vec4& p : planes) {
+            const glm::vec3 n = glm::vec3(p);
+            const float distance = glm::dot(n, center) + p.w;
+            const float radius = glm::dot(glm::abs(n), half);
+            if (distance + radius < 0.0f) return Result::Outside;
+            if (distance - radius < 0.0f) result = Result::Intersects;
+        }
+        return result;
+    }
+};
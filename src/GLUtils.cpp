@@ -1,14 +1,311 @@
 #include "GLUtils.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
 #include <vector>
-#include <cmath>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
 // Vertex layout: position (3 floats), normal (3 floats), texcoord (2 floats) -> 8 floats per vertex.
+// Builders emit triangle soup which indexMesh() welds and reorders.
+
+// --- Indexing / vertex cache optimization ---
+
+namespace
+{
+    // Bitwise vertex key: welds only vertices that are exactly identical (all 8 floats)
+    struct VertexKey
+    {
+        uint32_t bits[MeshData::kFloatsPerVertex];
+
+        bool operator==(const VertexKey& other) const
+        {
+            return std::memcmp(bits, other.bits, sizeof(bits)) == 0;
+        }
+    };
+
+    struct VertexKeyHash
+    {
+        size_t operator()(const VertexKey& key) const
+        {
+            // FNV-1a over the words
+            uint64_t h = 1469598103934665603ull;
+            for (uint32_t word : key.bits)
+            {
+                h ^= word;
+                h *= 1099511628211ull;
+            }
+            return static_cast<size_t>(h);
+        }
+    };
+
+    // Forsyth, "Linear-Speed Vertex Cache Optimisation": score of a vertex from its position in a
+    // simulated LRU cache (-1 = not cached) and the number of triangles still using it.
+    float ForsythVertexScore(int cachePosition, uint32_t remainingTriangles)
+    {
+        if (remainingTriangles == 0) return -1.0f;
+
+        float score = 0.0f;
+        if (cachePosition >= 0)
+        {
+            if (cachePosition < 3)
+            {
+                // The last triangle's vertices get a fixed score so its neighbors aren't favored too much
+                score = 0.75f;
+            }
+            else
+            {
+                const float scaler = 1.0f / static_cast<float>(kVertexCacheSize - 3);
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, 1.5f);
+            }
+        }
+
+        // Boost vertices with few triangles left so lone triangles are not left for the end
+        score += 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+        return score;
+    }
+
+    // Reorders triangles (not vertices) for post-transform cache reuse.
+    void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount)
+    {
+        const size_t triangleCount = indices.size() / 3;
+        if (triangleCount == 0) return;
+
+        // Vertex -> triangles adjacency (CSR); the first remaining[v] entries of a vertex's
+        // range are the triangles not emitted yet
+        std::vector<uint32_t> remaining(vertexCount, 0);
+        for (uint32_t index : indices) ++remaining[index];
+
+        std::vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+        for (size_t v = 0; v < vertexCount; ++v)
+            adjacencyStart[v + 1] = adjacencyStart[v] + remaining[v];
+
+        std::vector<uint32_t> adjacency(indices.size());
+        {
+            std::vector<uint32_t> cursor(adjacencyStart.begin(), adjacencyStart.end() - 1);
+            for (size_t i = 0; i < indices.size(); ++i)
+                adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+
+        std::vector<int> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScore(vertexCount);
+        for (size_t v = 0; v < vertexCount; ++v)
+            vertexScore[v] = ForsythVertexScore(-1, remaining[v]);
+
+        std::vector<float> triangleScore(triangleCount);
+        std::vector<uint8_t> emitted(triangleCount, 0);
+        for (size_t t = 0; t < triangleCount; ++t)
+            triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+
+        std::vector<uint32_t> output;
+        output.reserve(indices.size());
+        std::vector<uint32_t> cache, nextCache;
+        cache.reserve(kVertexCacheSize + 3);
+        nextCache.reserve(kVertexCacheSize + 3);
+
+        int64_t best = -1;
+        size_t scanStart = 0;
+        while (output.size() < indices.size())
+        {
+            if (best < 0)
+            {
+                // Nothing useful in the cache: fall back to the best remaining triangle overall
+                float bestScore = -FLT_MAX;
+                while (emitted[scanStart]) ++scanStart;
+                for (size_t t = scanStart; t < triangleCount; ++t)
+                {
+                    if (!emitted[t] && triangleScore[t] > bestScore)
+                    {
+                        bestScore = triangleScore[t];
+                        best = static_cast<int64_t>(t);
+                    }
+                }
+            }
+
+            const size_t tri = static_cast<size_t>(best);
+            emitted[tri] = 1;
+
+            // Emit and drop the triangle from its vertices' remaining lists
+            nextCache.clear();
+            for (int k = 0; k < 3; ++k)
+            {
+                const uint32_t v = indices[tri * 3 + k];
+                output.push_back(v);
+                if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end())
+                    nextCache.push_back(v);
+
+                uint32_t* list = &adjacency[adjacencyStart[v]];
+                for (uint32_t i = 0; i < remaining[v]; ++i)
+                {
+                    if (list[i] == tri)
+                    {
+                        list[i] = list[remaining[v] - 1];
+                        list[remaining[v] - 1] = static_cast<uint32_t>(tri);
+                        --remaining[v];
+                        break;
+                    }
+                }
+            }
+
+            // LRU update: the triangle's vertices move to the front
+            const size_t emittedCount = nextCache.size();
+            for (uint32_t v : cache)
+            {
+                const auto emittedEnd = nextCache.begin() + static_cast<std::ptrdiff_t>(emittedCount);
+                if (std::find(nextCache.begin(), emittedEnd, v) == emittedEnd)
+                    nextCache.push_back(v);
+            }
+
+            // Rescore every vertex that was or still is in the cache, then its triangles
+            for (size_t i = 0; i < nextCache.size(); ++i)
+            {
+                const uint32_t v = nextCache[i];
+                cachePosition[v] = i < kVertexCacheSize ? static_cast<int>(i) : -1;
+                vertexScore[v] = ForsythVertexScore(cachePosition[v], remaining[v]);
+            }
+
+            best = -1;
+            float bestScore = -FLT_MAX;
+            for (uint32_t v : nextCache)
+            {
+                for (uint32_t i = 0; i < remaining[v]; ++i)
+                {
+                    const uint32_t t = adjacency[adjacencyStart[v] + i];
+                    const float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+                    triangleScore[t] = score;
+                    if (score > bestScore)
+                    {
+                        bestScore = score;
+                        best = t;
+                    }
+                }
+            }
+
+            if (nextCache.size() > kVertexCacheSize)
+                nextCache.resize(kVertexCacheSize);
+            cache.swap(nextCache);
+        }
+
+        indices.swap(output);
+    }
+
+    // Renumbers vertices in order of first use so vertex fetches walk the buffer linearly.
+    void OptimizeVertexFetch(MeshData& mesh)
+    {
+        constexpr size_t stride = MeshData::kFloatsPerVertex;
+        const size_t vertexCount = mesh.GetVertexCount();
+
+        std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+        std::vector<float> vertices;
+        vertices.reserve(mesh.vertices.size());
+
+        for (uint32_t& index : mesh.indices)
+        {
+            if (remap[index] == UINT32_MAX)
+            {
+                remap[index] = static_cast<uint32_t>(vertices.size() / stride);
+                const float* v = &mesh.vertices[index * stride];
+                vertices.insert(vertices.end(), v, v + stride);
+            }
+            index = remap[index];
+        }
+
+        mesh.vertices.swap(vertices);
+    }
+}
+
+float computeACMR(const std::vector<uint32_t>& indices, size_t cacheSize)
+{
+    const size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return 0.0f;
+
+    // FIFO cache: a hit does not refresh the entry's position
+    std::vector<uint32_t> fifo(cacheSize, UINT32_MAX);
+    size_t head = 0;
+    size_t misses = 0;
+    for (uint32_t index : indices)
+    {
+        if (std::find(fifo.begin(), fifo.end(), index) != fifo.end()) continue;
+        fifo[head] = index;
+        head = (head + 1) % cacheSize;
+        ++misses;
+    }
+    return static_cast<float>(misses) / static_cast<float>(triangleCount);
+}
+
+MeshData indexMesh(const std::vector<float>& soup)
+{
+    constexpr size_t stride = MeshData::kFloatsPerVertex;
+
+    MeshData mesh;
+    mesh.soupVertexCount = soup.size() / stride;
+    mesh.indices.reserve(mesh.soupVertexCount);
+
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+    unique.reserve(mesh.soupVertexCount);
+    for (size_t i = 0; i < mesh.soupVertexCount; ++i)
+    {
+        VertexKey key;
+        std::memcpy(key.bits, &soup[i * stride], sizeof(key.bits));
+
+        const uint32_t next = static_cast<uint32_t>(unique.size());
+        auto [it, inserted] = unique.emplace(key, next);
+        if (inserted)
+            mesh.vertices.insert(mesh.vertices.end(), &soup[i * stride], &soup[i * stride] + stride);
+        mesh.indices.push_back(it->second);
+    }
+
+    mesh.acmrBefore = computeACMR(mesh.indices);
+    OptimizeVertexCache(mesh.indices, mesh.GetVertexCount());
+    OptimizeVertexFetch(mesh);
+    mesh.acmrAfter = computeACMR(mesh.indices);
+
+    return mesh;
+}
+
+GLuint createMeshVAO(const MeshData& mesh)
+{
+    GLuint VAO = 0, VBO = 0, EBO = 0;
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * sizeof(float), mesh.vertices.data(), GL_STATIC_DRAW);
+
+    // Element buffer binding is recorded in the VAO
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(uint32_t), mesh.indices.data(), GL_STATIC_DRAW);
+
+    constexpr GLsizei stride = static_cast<GLsizei>(MeshData::kFloatsPerVertex * sizeof(float));
+
+    // position attribute (location = 0): vec3
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(0));
+
+    // normal attribute (location = 1): vec3
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(3 * sizeof(float)));
+
+    // texcoord attribute (location = 2): vec2
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(6 * sizeof(float)));
+
+    // Unbind VAO first so it keeps the element buffer (VBO/EBO stay bound to VAO state)
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return VAO;
+}
 
 // Cube (36 vertices)
 static const float kCubeVertices[] = {
@@ -61,35 +358,14 @@ static const float kCubeVertices[] = {
     -0.5f,  0.5f,  0.5f,  0.0f, 1.0f, 0.0f,  0.0f, 0.0f
 };
 
-GLuint createCubeVAO()
+MeshData buildCubeMesh()
 {
-    GLuint VAO = 0, VBO = 0;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(kCubeVertices), kCubeVertices, GL_STATIC_DRAW);
-
-    constexpr GLsizei stride = static_cast<GLsizei>(8 * sizeof(float));
-
-    // position attribute (location = 0): vec3
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(0));
-
-    // normal attribute (location = 1): vec3
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(3 * sizeof(float)));
-
-    // texcoord attribute (location = 2): vec2
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(6 * sizeof(float)));
-
-    // Unbind VAO (VBO stays bound to VAO state)
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return indexMesh(std::vector<float>(std::begin(kCubeVertices), std::end(kCubeVertices)));
+}
 
-    return VAO;
+GLuint createCubeVAO()
+{
+    return createMeshVAO(buildCubeMesh());
 }
 
 // Plane (two triangles, 6 vertices): XZ plane centered at origin, normal = +Y
@@ -104,38 +380,18 @@ static const float kPlaneVertices[] = {
     -0.5f, 0.0f, -0.5f,    0.0f,1.0f,0.0f,   0.0f, 0.0f
 };
 
-GLuint createPlaneVAO()
+MeshData buildPlaneMesh()
 {
-    GLuint VAO = 0, VBO = 0;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(kPlaneVertices), kPlaneVertices, GL_STATIC_DRAW);
-
-    constexpr GLsizei stride = static_cast<GLsizei>(8 * sizeof(float));
-
-    // position (location = 0)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(0));
-
-    // normal (location = 1)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(3 * sizeof(float)));
-
-    // texcoord (location = 2)
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(6 * sizeof(float)));
-
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return indexMesh(std::vector<float>(std::begin(kPlaneVertices), std::end(kPlaneVertices)));
+}
 
-    return VAO;
+GLuint createPlaneVAO()
+{
+    return createMeshVAO(buildPlaneMesh());
 }
 
 // Pyramid: 5 faces (4 triangular sides + 1 square base) = 18 vertices
-GLuint createPyramidVAO()
+MeshData buildPyramidMesh()
 {
     std::vector<float> vertices;
     
@@ -192,30 +448,16 @@ GLuint createPyramidVAO()
     addVertex(v3[0], v3[1], v3[2], 0.0f, -1.0f, 0.0f);
     addVertex(v2[0], v2[1], v2[2], 0.0f, -1.0f, 0.0f);
     
-    GLuint VAO = 0, VBO = 0;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    
-    constexpr GLsizei stride = 8 * sizeof(float);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    
-    return VAO;
+    return indexMesh(vertices);
+}
+
+GLuint createPyramidVAO()
+{
+    return createMeshVAO(buildPyramidMesh());
 }
 
 // Cylinder: Y-axis aligned, radius 0.5, height 1
-GLuint createCylinderVAO()
+MeshData buildCylinderMesh()
 {
     const int segments = 16;
     const float radius = 0.5f;
@@ -285,30 +527,16 @@ GLuint createCylinderVAO()
         addVertex(x1, -halfHeight, z1, 0.0f, -1.0f, 0.0f);
     }
     
-    GLuint VAO = 0, VBO = 0;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    
-    constexpr GLsizei stride = 8 * sizeof(float);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    
-    return VAO;
+    return indexMesh(vertices);
+}
+
+GLuint createCylinderVAO()
+{
+    return createMeshVAO(buildCylinderMesh());
 }
 
 // Cone: Y-axis aligned, base radius 0.5, height 1
-GLuint createConeVAO()
+MeshData buildConeMesh()
 {
     const int segments = 16;
     const float radius = 0.5f;
@@ -359,30 +587,16 @@ GLuint createConeVAO()
         addVertex(x1, -halfHeight, z1, 0.0f, -1.0f, 0.0f);
     }
     
-    GLuint VAO = 0, VBO = 0;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    
-    constexpr GLsizei stride = 8 * sizeof(float);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    
-    return VAO;
+    return indexMesh(vertices);
+}
+
+GLuint createConeVAO()
+{
+    return createMeshVAO(buildConeMesh());
 }
 
 // Sphere: UV sphere with latitude/longitude segments
-GLuint createSphereVAO()
+MeshData buildSphereMesh()
 {
     const int latSegments = 16;
     const int lonSegments = 32;
@@ -435,24 +649,10 @@ GLuint createSphereVAO()
         }
     }
     
-    GLuint VAO = 0, VBO = 0;
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
-    
-    constexpr GLsizei stride = 8 * sizeof(float);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0);
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(6 * sizeof(float)));
-    
-    glBindVertexArray(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    
-    return VAO;
+    return indexMesh(vertices);
+}
+
+GLuint createSphereVAO()
+{
+    return createMeshVAO(buildSphereMesh());
 }
\ No newline at end of file
@@ -1,9 +1,61 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Number of indices in each primitive's element buffer (GL_TRIANGLES, GL_UNSIGNED_INT).
+// Draw calls must use these instead of guessing the tessellation.
+constexpr GLsizei kCubeIndexCount = 36;
+constexpr GLsizei kPlaneIndexCount = 6;
+constexpr GLsizei kPyramidIndexCount = 18;
+constexpr GLsizei kCylinderIndexCount = 16 * 12; // 16 segments: side quad (6) + top fan (3) + bottom fan (3)
+constexpr GLsizei kConeIndexCount = 16 * 6;      // 16 segments: side (3) + base fan (3)
+constexpr GLsizei kSphereIndexCount = 16 * 32 * 6; // lat * lon * 6 indices per quad
+
+// Simulated post-transform vertex cache size used by the reorder and the ACMR report
+constexpr size_t kVertexCacheSize = 32;
+
+// CPU copy of a primitive: indexed GL_TRIANGLES, position (3), normal (3), texcoord (2) per vertex.
+// The createXVAO functions upload exactly these; StaticBatcher transforms and merges them.
+struct MeshData
+{
+    static constexpr size_t kFloatsPerVertex = 8;
+
+    std::vector<float> vertices;   // unique vertices
+    std::vector<uint32_t> indices;
+
+    // Filled by indexMesh (for reports)
+    size_t soupVertexCount = 0; // vertices of the non-indexed input
+    float acmrBefore = 0.0f;    // average cache misses per triangle after welding, input triangle order
+    float acmrAfter = 0.0f;     // same after the cache reorder
+
+    size_t GetVertexCount() const { return vertices.size() / kFloatsPerVertex; }
+    size_t GetIndexCount() const { return indices.size(); }
+};
+
+// Welds bit-identical vertices of a triangle soup (kFloatsPerVertex floats per vertex), reorders
+// the triangles for the post-transform cache (Forsyth's linear-speed algorithm) and renumbers
+// the vertices in first-use order.
+MeshData indexMesh(const std::vector<float>& soup);
+
+// Average cache miss ratio: vertex shader invocations per triangle with a FIFO cache of cacheSize
+// entries (3.0 = no reuse; ~0.5-0.7 is typical for well-ordered regular meshes).
+float computeACMR(const std::vector<uint32_t>& indices, size_t cacheSize = kVertexCacheSize);
+
+MeshData buildCubeMesh();
+MeshData buildPlaneMesh();
+MeshData buildPyramidMesh();
+MeshData buildCylinderMesh();
+MeshData buildConeMesh();
+MeshData buildSphereMesh();
+
+// Uploads mesh into a new VAO with a VBO (attributes 0 position, 1 normal, 2 texcoord) and an element buffer.
+GLuint createMeshVAO(const MeshData& mesh);
 
 // Creates and returns a VAO for a unit cube centered at origin.
-// The VBO is created and remains bound to the VAO (caller may delete via glDeleteBuffers later if desired).
+// The VBO and element buffer are created and remain bound to the VAO (caller may delete them later if desired).
 GLuint createCubeVAO();
 
 // Creates and returns a VAO for a unit plane (XZ) centered at origin, y = 0.
@@ -0,0 +1,91 @@
+#include "GpuParticleSystem.h"
+
+#include <cstddef>
+#include <vector>
+
+bool GpuParticleSystem::IsSupported()
+{
+    return GLAD_GL_VERSION_4_3 || GLAD_GL_ARB_compute_shader;
+}
+
+GpuParticleSystem::GpuParticleSystem(unsigned int amount)
+    : amount(amount),
+      simShader(Shader::FromCompute("shaders/particle_sim.comp"))
+{
+    particleCountUniform = simShader.GetUniform<unsigned int>("particleCount");
+    frameSeedUniform = simShader.GetUniform<unsigned int>("frameSeed");
+    dtUniform = simShader.GetUniform<float>("dt");
+    gravityUniform = simShader.GetUniform<glm::vec3>("gravity");
+    spawnPositionUniform = simShader.GetUniform<glm::vec3>("spawnPosition");
+    spawnOffsetUniform = simShader.GetUniform<glm::vec3>("spawnOffset");
+    fadeRateUniform = simShader.GetUniform<float>("fadeRate");
+    floorYUniform = simShader.GetUniform<float>("floorY");
+    bounceUniform = simShader.GetUniform<float>("bounce");
+    frictionUniform = simShader.GetUniform<float>("friction");
+
+    // All slots start dead (life = 0)
+    const std::vector<GpuParticle> initial(amount, GpuParticle{ glm::vec4(0.0f), glm::vec4(0.0f) });
+    glGenBuffers(1, &particleBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, particleBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, initial.size() * sizeof(GpuParticle), initial.data(), GL_DYNAMIC_COPY);
+
+    const int32_t zero = 0;
+    glGenBuffers(1, &emitBuffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, emitBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(int32_t), &zero, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    // The storage buffer doubles as the vertex buffer: position.xyz + life, and alpha per vertex
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, particleBuffer);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(GpuParticle), (void*)offsetof(GpuParticle, positionLife));
+    glEnableVertexAttribArray(1); // alpha
+    glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, sizeof(GpuParticle), (void*)(offsetof(GpuParticle, velocityAlpha) + 3 * sizeof(float)));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+GpuParticleSystem::~GpuParticleSystem()
+{
+    if (VAO != 0) glDeleteVertexArrays(1, &VAO);
+    if (particleBuffer != 0) glDeleteBuffers(1, &particleBuffer);
+    if (emitBuffer != 0) glDeleteBuffers(1, &emitBuffer);
+}
+
+void GpuParticleSystem::Update(float dt, unsigned int newParticles, glm::vec3 offset)
+{
+    // Reset this frame's emit budget (last frame's atomic writes are ordered by the barrier below)
+    const int32_t budget = static_cast<int32_t>(newParticles);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, emitBuffer);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, sizeof(int32_t), &budget);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kParticleBinding, particleBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, kEmitBinding, emitBuffer);
+
+    simShader.Use();
+    simShader.Set(particleCountUniform, amount);
+    simShader.Set(frameSeedUniform, frame++);
+    simShader.Set(dtUniform, dt);
+    simShader.Set(gravityUniform, Gravity);
+    simShader.Set(spawnPositionUniform, SpawnPosition);
+    simShader.Set(spawnOffsetUniform, offset);
+    simShader.Set(fadeRateUniform, 0.5f);
+    simShader.Set(floorYUniform, 5.8f);
+    simShader.Set(bounceUniform, 0.2f);
+    simShader.Set(frictionUniform, 0.6f);
+    simShader.Dispatch((amount + kWorkGroupSize - 1) / kWorkGroupSize);
+
+    // The draw reads the results as vertex attributes, the next dispatch reads them back through
+    // the SSBO, and the next budget reset overwrites the counter with glBufferSubData
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+void GpuParticleSystem::Draw()
+{
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(amount));
+    glBindVertexArray(0);
+}
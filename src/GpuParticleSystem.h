@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+#include "Shader.h"
+
+// Compute-shader backend for the fountain, as an alternative to ParticleSystem.
+// Particle state lives in a shader storage buffer that is never read back: particle_sim.comp
+// emits, integrates and bounces particles in place, and Draw() uses the same buffer as the
+// vertex buffer (particle_gpu.vs skips dead slots). Needs GL 4.3 or ARB_compute_shader.
+class GpuParticleSystem
+{
+public:
+    static constexpr GLuint kParticleBinding = 0; // SSBO binding points (layout(binding) in the shader)
+    static constexpr GLuint kEmitBinding = 1;
+    static constexpr GLuint kWorkGroupSize = 64;  // local_size_x in particle_sim.comp
+
+    // True if the current context can run compute shaders
+    static bool IsSupported();
+
+    explicit GpuParticleSystem(unsigned int amount);
+    ~GpuParticleSystem();
+
+    GpuParticleSystem(const GpuParticleSystem&) = delete;
+    GpuParticleSystem& operator=(const GpuParticleSystem&) = delete;
+
+    // Same meaning as ParticleSystem::Update: spawn up to newParticles into dead slots, then step by dt
+    void Update(float dt, unsigned int newParticles, glm::vec3 offset = glm::vec3(0.0f));
+
+    // Draws every slot as a point; bind a program using particle_gpu.vs first
+    // (location 0 = position + life, location 1 = alpha)
+    void Draw();
+
+    unsigned int GetCapacity() const { return amount; }
+
+    // Config (same defaults as ParticleSystem)
+    glm::vec3 SpawnPosition = glm::vec3(0.0f);
+    glm::vec3 Gravity = glm::vec3(0.0f, -9.8f, 0.0f);
+
+private:
+    // Must match struct Particle in particle_sim.comp (std430)
+    struct GpuParticle
+    {
+        glm::vec4 positionLife;
+        glm::vec4 velocityAlpha;
+    };
+
+    unsigned int amount;
+    uint32_t frame = 0;
+
+    Shader simShader;
+    Uniform<unsigned int> particleCountUniform;
+    Uniform<unsigned int> frameSeedUniform;
+    Uniform<float> dtUniform;
+    Uniform<glm::vec3> gravityUniform;
+    Uniform<glm::vec3> spawnPositionUniform;
+    Uniform<glm::vec3> spawnOffsetUniform;
+    Uniform<float> fadeRateUniform;
+    Uniform<float> floorYUniform;
+    Uniform<float> bounceUniform;
+    Uniform<float> frictionUniform;
+
+    GLuint particleBuffer = 0;
+    GLuint emitBuffer = 0;
+    GLuint VAO = 0;
+};
@@ -0,0 +1,106 @@
+#include "InstancedRenderer.h"
+
+InstancedRenderer::~InstancedRenderer()
+{
+    for (auto& batch : batches)
+    {
+        if (batch.instanceVBO != 0)
+            glDeleteBuffers(1, &batch.instanceVBO);
+    }
+}
+
+void InstancedRenderer::RegisterMesh(MeshType type, GLuint vao, GLsizei indexCount)
+{
+    Batch& batch = batches[static_cast<size_t>(type)];
+    batch.vao = vao;
+    batch.indexCount = indexCount;
+
+    if (batch.instanceVBO == 0)
+        glGenBuffers(1, &batch.instanceVBO);
+
+    // Allocate a non-empty buffer up front so the enabled per-instance attributes
+    // always point at valid storage, even for the non-instanced draw path.
+    batch.capacity = kInitialCapacity;
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, batch.instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, batch.capacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+
+    constexpr GLsizei stride = static_cast<GLsizei>(sizeof(InstanceData));
+
+    // model matrix (locations 3..6): one vec4 column per location
+    for (GLuint i = 0; i < 4; ++i)
+    {
+        glEnableVertexAttribArray(3 + i);
+        glVertexAttribPointer(3 + i, 4, GL_FLOAT, GL_FALSE, stride,
+                              reinterpret_cast<void*>(offsetof(InstanceData, model) + i * sizeof(glm::vec4)));
+        glVertexAttribDivisor(3 + i, 1);
+    }
+
+    // albedo (location = 7): vec3
+    glEnableVertexAttribArray(7);
+    glVertexAttribPointer(7, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(offsetof(InstanceData, albedo)));
+    glVertexAttribDivisor(7, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstancedRenderer::Begin()
+{
+    for (auto& batch : batches)
+        batch.instances.clear();
+}
+
+void InstancedRenderer::Gather(const SceneNode::Ptr& node)
+{
+    if (!node) return;
+
+    if (const MeshNode* meshNode = NodeCast<MeshNode>(node.get()))
+    {
+        Add(meshNode->GetMeshType(), meshNode->GetGlobalTransform(), meshNode->GetMaterial().albedo);
+    }
+
+    for (auto& c : node->children)
+        Gather(c);
+}
+
+void InstancedRenderer::Add(MeshType type, const glm::mat4& model, const glm::vec3& albedo)
+{
+    batches[static_cast<size_t>(type)].instances.push_back({ model, glm::vec4(albedo, 1.0f) });
+}
+
+void InstancedRenderer::Draw(const Shader& shader)
+{
+    instanceCount = 0;
+    drawCallCount = 0;
+
+    shader.SetBool("useInstancing", true);
+
+    for (auto& batch : batches)
+    {
+        if (batch.vao == 0 || batch.instances.empty()) continue;
+
+        const size_t count = batch.instances.size();
+        glBindBuffer(GL_ARRAY_BUFFER, batch.instanceVBO);
+        if (count > batch.capacity)
+        {
+            // Grow geometrically so the buffer is reallocated only a few times
+            while (batch.capacity < count) batch.capacity *= 2;
+        }
+        // Orphan the previous storage so the driver does not stall on in-flight draws
+        glBufferData(GL_ARRAY_BUFFER, batch.capacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData), batch.instances.data());
+
+        glBindVertexArray(batch.vao);
+        glDrawElementsInstanced(GL_TRIANGLES, batch.indexCount, GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(count));
+
+        instanceCount += count;
+        ++drawCallCount;
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    shader.SetBool("useInstancing", false);
+}
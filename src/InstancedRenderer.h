@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "SceneNode.h"
+#include "SchoolBuilder.h"
+#include "Shader.h"
+
+// Per-instance attributes streamed alongside the mesh vertices.
+// Layout matches scene.vs: model matrix at locations 3-6, albedo at location 7.
+struct InstanceData
+{
+    glm::mat4 model;
+    glm::vec4 albedo; // rgb = albedo, w unused (keeps a 16-byte aligned stride)
+};
+
+// Alternative to the recursive RenderNode path:
+// - Gathers every MeshNode into one instance buffer per MeshType
+// - Draws each primitive type with a single glDrawElementsInstanced call
+class InstancedRenderer
+{
+public:
+    InstancedRenderer() = default;
+    ~InstancedRenderer();
+
+    InstancedRenderer(const InstancedRenderer&) = delete;
+    InstancedRenderer& operator=(const InstancedRenderer&) = delete;
+
+    // Attaches a per-instance buffer to an existing indexed mesh VAO (from GLUtils).
+    void RegisterMesh(MeshType type, GLuint vao, GLsizei indexCount);
+
+    // Clears all batches. Call once per frame before Gather/Add.
+    void Begin();
+
+    // Recursively adds every MeshNode below (and including) node.
+    void Gather(const SceneNode::Ptr& node);
+
+    // Adds a single instance to the batch of the given mesh type.
+    void Add(MeshType type, const glm::mat4& model, const glm::vec3& albedo);
+
+    // Uploads all batches and issues one instanced draw per non-empty MeshType.
+    // The shader must already be in use; toggles its "useInstancing" uniform.
+    void Draw(const Shader& shader);
+
+    // Stats for the last Draw()
+    size_t GetInstanceCount() const { return instanceCount; }
+    size_t GetDrawCallCount() const { return drawCallCount; }
+
+private:
+    struct Batch
+    {
+        GLuint vao = 0;
+        GLuint instanceVBO = 0;
+        GLsizei indexCount = 0;
+        size_t capacity = 0; // instances the GPU buffer can currently hold
+        std::vector<InstanceData> instances;
+    };
+
+    static constexpr size_t kMeshTypeCount = static_cast<size_t>(MeshType::Sphere) + 1;
+    static constexpr size_t kInitialCapacity = 64;
+
+    std::array<Batch, kMeshTypeCount> batches;
+    size_t instanceCount = 0;
+    size_t drawCallCount = 0;
+};
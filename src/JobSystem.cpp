@@ -0,0 +1,113 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+
+unsigned int JobSystem::DefaultThreadCount()
+{
+    const unsigned int hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 0;
+}
+
+JobSystem::JobSystem(unsigned int workerCount)
+{
+    StartWorkers(workerCount);
+}
+
+JobSystem::~JobSystem()
+{
+    StopWorkers();
+}
+
+void JobSystem::SetWorkerCount(unsigned int workerCount)
+{
+    if (workerCount == workers.size()) return;
+    StopWorkers();
+    StartWorkers(workerCount);
+}
+
+void JobSystem::StartWorkers(unsigned int workerCount)
+{
+    stopping = false;
+    workers.reserve(workerCount);
+    for (unsigned int i = 0; i < workerCount; ++i)
+        workers.emplace_back(&JobSystem::WorkerLoop, this);
+}
+
+void JobSystem::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+
+    // Workers are gone: anything still queued runs here so no group is left pending
+    while (RunOne()) {}
+}
+
+void JobSystem::Dispatch(JobGroup& group, size_t count, size_t chunkSize, RangeFn fn)
+{
+    if (count == 0) return;
+    chunkSize = std::max<size_t>(chunkSize, 1);
+    const size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+    const auto shared = std::make_shared<const RangeFn>(std::move(fn));
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        group.pending.fetch_add(chunks, std::memory_order_relaxed);
+        for (size_t begin = 0; begin < count; begin += chunkSize)
+            queue.push_back(Job{ &group, shared, begin, std::min(begin + chunkSize, count) });
+    }
+    wake.notify_all();
+}
+
+bool JobSystem::RunOne()
+{
+    Job job;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) return false;
+        job = queue.front();
+        queue.pop_front();
+    }
+
+    (*job.fn)(job.begin, job.end);
+    job.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+void JobSystem::Wait(JobGroup& group)
+{
+    while (!group.IsDone())
+    {
+        // Help out; once the queue is empty the remaining chunks are already running elsewhere
+        if (!RunOne()) std::this_thread::yield();
+    }
+}
+
+void JobSystem::ParallelFor(size_t count, size_t chunkSize, RangeFn fn)
+{
+    JobGroup group;
+    Dispatch(group, count, chunkSize, std::move(fn));
+    Wait(group);
+}
+
+void JobSystem::WorkerLoop()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            job = queue.front();
+            queue.pop_front();
+        }
+
+        (*job.fn)(job.begin, job.end);
+        job.group->pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
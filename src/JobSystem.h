@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small worker pool for data-parallel engine work (particle integration, ...).
+// Work is submitted as a JobGroup of chunks; Dispatch() returns immediately so the caller can
+// keep working (e.g. submitting draw calls) and Wait() later. A thread that waits helps run
+// queued chunks instead of sleeping, so a pool with 0 workers still makes progress.
+class JobSystem
+{
+public:
+    // Completion counter for one Dispatch (must outlive the dispatched work)
+    struct JobGroup
+    {
+        std::atomic<size_t> pending{ 0 };
+        bool IsDone() const { return pending.load(std::memory_order_acquire) == 0; }
+    };
+
+    // fn(begin, end) processes one chunk of [0, count)
+    using RangeFn = std::function<void(size_t begin, size_t end)>;
+
+    // Default: one worker per hardware thread, minus the calling (render) thread
+    static unsigned int DefaultThreadCount();
+
+    explicit JobSystem(unsigned int workerCount = DefaultThreadCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Stops and restarts the workers; must not be called while work is in flight
+    void SetWorkerCount(unsigned int workerCount);
+    unsigned int GetWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+    // Splits [0, count) into chunks of chunkSize and queues them
+    void Dispatch(JobGroup& group, size_t count, size_t chunkSize, RangeFn fn);
+
+    // Runs queued chunks on this thread until the group has finished
+    void Wait(JobGroup& group);
+
+    // Dispatch + Wait
+    void ParallelFor(size_t count, size_t chunkSize, RangeFn fn);
+
+private:
+    struct Job
+    {
+        JobGroup* group;
+        std::shared_ptr<const RangeFn> fn; // shared by all chunks of one Dispatch
+        size_t begin, end;
+    };
+
+    void WorkerLoop();
+    bool RunOne(); // pops and runs one queued job; false if the queue was empty
+    void StartWorkers(unsigned int workerCount);
+    void StopWorkers();
+
+    std::vector<std::thread> workers;
+    std::deque<Job> queue;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+};
@@ -0,0 +1,190 @@
+#include "LightClusterer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    // Maps an NDC coordinate range to an inclusive tile range on a grid of the given size.
+    void NdcToTiles(float ndcMin, float ndcMax, uint32_t gridSize, uint8_t& t0, uint8_t& t1)
+    {
+        const float g = static_cast<float>(gridSize);
+        const int lo = static_cast<int>(std::floor((ndcMin * 0.5f + 0.5f) * g));
+        const int hi = static_cast<int>(std::floor((ndcMax * 0.5f + 0.5f) * g));
+        t0 = static_cast<uint8_t>(std::clamp(lo, 0, static_cast<int>(gridSize) - 1));
+        t1 = static_cast<uint8_t>(std::clamp(hi, 0, static_cast<int>(gridSize) - 1));
+    }
+}
+
+LightClusterer::LightClusterer()
+{
+    SetDepthRange(nearZ, farZ);
+
+    counts.resize(kClusterCount);
+    grid.resize(kClusterCount * 2);
+
+    GLint maxTexels = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+    maxIndices = static_cast<size_t>(std::max<GLint>(maxTexels, 65536)); // GL minimum
+
+    glGenBuffers(1, &gridBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, gridBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, grid.size() * sizeof(uint32_t), nullptr, GL_STREAM_DRAW);
+    glGenTextures(1, &gridTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, gridTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32UI, gridBuffer);
+
+    // Start with room for a few lights per cluster; grows geometrically in Build()
+    indexCapacity = kClusterCount * 4;
+    glGenBuffers(1, &indexBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, indexBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, indexCapacity * sizeof(uint32_t), nullptr, GL_STREAM_DRAW);
+    glGenTextures(1, &indexTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_R32UI, indexBuffer);
+
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+LightClusterer::~LightClusterer()
+{
+    if (gridTexture != 0) glDeleteTextures(1, &gridTexture);
+    if (indexTexture != 0) glDeleteTextures(1, &indexTexture);
+    if (gridBuffer != 0) glDeleteBuffers(1, &gridBuffer);
+    if (indexBuffer != 0) glDeleteBuffers(1, &indexBuffer);
+}
+
+void LightClusterer::SetDepthRange(float newNearZ, float newFarZ)
+{
+    nearZ = std::max(newNearZ, 1e-3f);
+    farZ = std::max(newFarZ, nearZ * 1.01f);
+
+    // Exponential slicing: slice i spans [near * (far/near)^(i/Z), near * (far/near)^((i+1)/Z)]
+    const float logRatio = std::log(farZ / nearZ);
+    sliceScale = static_cast<float>(kGridZ) / logRatio;
+    sliceBias = -static_cast<float>(kGridZ) * std::log(nearZ) / logRatio;
+}
+
+uint32_t LightClusterer::SliceForDepth(float depth) const
+{
+    if (depth <= nearZ) return 0;
+    const int slice = static_cast<int>(std::floor(std::log(depth) * sliceScale + sliceBias));
+    return static_cast<uint32_t>(std::clamp(slice, 0, static_cast<int>(kGridZ) - 1));
+}
+
+void LightClusterer::Build(const std::vector<PointLight>& lights, float intensityScale,
+                           const glm::mat4& view, const glm::mat4& projection)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    ranges.clear();
+    std::fill(counts.begin(), counts.end(), 0u);
+
+    // 1. Cluster range of every visible light's bounding sphere
+    if (intensityScale > 0.0f)
+    {
+        const float p00 = projection[0][0];
+        const float p11 = projection[1][1];
+
+        for (size_t i = 0; i < lights.size(); ++i)
+        {
+            const PointLight& light = lights[i];
+            // The shader fades each light to zero at light.radius, so nothing lies outside it
+            const float radius = light.radius;
+            if (radius <= 0.0f) continue;
+
+            const glm::vec3 c = glm::vec3(view * glm::vec4(light.position, 1.0f));
+            const float centerDepth = -c.z;
+            const float dMin = std::max(centerDepth - radius, 1e-3f);
+            const float dMax = centerDepth + radius;
+            if (dMax <= 1e-3f || dMin > farZ) continue; // behind the camera or beyond the slices
+
+            // Conservative projected extent: each side of the sphere's view-space box is projected
+            // at whichever depth in [dMin, dMax] pushes it furthest outwards.
+            const float xLo = c.x - radius, xHi = c.x + radius;
+            const float yLo = c.y - radius, yHi = c.y + radius;
+            const float ndcXMin = p00 * xLo / (xLo < 0.0f ? dMin : dMax);
+            const float ndcXMax = p00 * xHi / (xHi > 0.0f ? dMin : dMax);
+            const float ndcYMin = p11 * yLo / (yLo < 0.0f ? dMin : dMax);
+            const float ndcYMax = p11 * yHi / (yHi > 0.0f ? dMin : dMax);
+            if (ndcXMax < -1.0f || ndcXMin > 1.0f || ndcYMax < -1.0f || ndcYMin > 1.0f) continue;
+
+            LightRange r;
+            r.light = static_cast<uint32_t>(i);
+            NdcToTiles(ndcXMin, ndcXMax, kGridX, r.x0, r.x1);
+            NdcToTiles(ndcYMin, ndcYMax, kGridY, r.y0, r.y1);
+            r.z0 = static_cast<uint8_t>(SliceForDepth(dMin));
+            r.z1 = static_cast<uint8_t>(SliceForDepth(dMax));
+            ranges.push_back(r);
+
+            for (uint32_t z = r.z0; z <= r.z1; ++z)
+                for (uint32_t y = r.y0; y <= r.y1; ++y)
+                    for (uint32_t x = r.x0; x <= r.x1; ++x)
+                        ++counts[(z * kGridY + y) * kGridX + x];
+        }
+    }
+
+    // 2. Prefix sum into (offset, count) pairs; lists past the texture buffer limit are truncated
+    size_t total = 0;
+    maxLightsPerCluster = 0;
+    occupiedClusters = 0;
+    for (uint32_t c = 0; c < kClusterCount; ++c)
+    {
+        uint32_t count = counts[c];
+        if (total + count > maxIndices)
+            count = static_cast<uint32_t>(maxIndices - total);
+
+        grid[c * 2] = static_cast<uint32_t>(total);
+        grid[c * 2 + 1] = count;
+        counts[c] = 0; // reused as the fill cursor below
+        total += count;
+
+        maxLightsPerCluster = std::max(maxLightsPerCluster, count);
+        if (count > 0) ++occupiedClusters;
+    }
+
+    // 3. Scatter light indices into their clusters' slots
+    indices.resize(total);
+    for (const LightRange& r : ranges)
+    {
+        for (uint32_t z = r.z0; z <= r.z1; ++z)
+            for (uint32_t y = r.y0; y <= r.y1; ++y)
+                for (uint32_t x = r.x0; x <= r.x1; ++x)
+                {
+                    const uint32_t c = (z * kGridY + y) * kGridX + x;
+                    uint32_t& cursor = counts[c];
+                    if (cursor < grid[c * 2 + 1])
+                        indices[grid[c * 2] + cursor++] = r.light;
+                }
+    }
+    indexCount = total;
+
+    // 4. Upload (orphaning the previous storage, as the data changes every frame)
+    glBindBuffer(GL_TEXTURE_BUFFER, gridBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, grid.size() * sizeof(uint32_t), grid.data(), GL_STREAM_DRAW);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, indexBuffer);
+    if (total > indexCapacity)
+    {
+        while (indexCapacity < total) indexCapacity *= 2;
+        indexCapacity = std::min(indexCapacity, maxIndices);
+    }
+    glBufferData(GL_TEXTURE_BUFFER, indexCapacity * sizeof(uint32_t), nullptr, GL_STREAM_DRAW);
+    if (total > 0)
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, total * sizeof(uint32_t), indices.data());
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+
+    const auto end = std::chrono::steady_clock::now();
+    lastBuildMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void LightClusterer::Bind() const
+{
+    glActiveTexture(GL_TEXTURE0 + kGridTextureUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, gridTexture);
+    glActiveTexture(GL_TEXTURE0 + kIndexTextureUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, indexTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
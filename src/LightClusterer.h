@@ -0,0 +1,89 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LightManager.h"
+
+// Clustered forward lighting: the view frustum is split into a kGridX x kGridY screen-space
+// grid and kGridZ exponentially spaced depth slices. Build() assigns every point light to the
+// clusters its sphere of influence touches and uploads two texture buffers:
+// - clusterGrid (RG32UI): per cluster, offset and count into the index list
+// - clusterLightIndices (R32UI): light indices, grouped per cluster
+// scene_lighting.fs then only evaluates the lights listed for the fragment's cluster.
+class LightClusterer
+{
+public:
+    static constexpr uint32_t kGridX = 16;
+    static constexpr uint32_t kGridY = 9;
+    static constexpr uint32_t kGridZ = 24;
+    static constexpr uint32_t kClusterCount = kGridX * kGridY * kGridZ;
+
+    // Texture units used by the cluster buffers (next to LightManager::kLightTextureUnit)
+    static constexpr GLuint kGridTextureUnit = 5;
+    static constexpr GLuint kIndexTextureUnit = 6;
+
+    LightClusterer();
+    ~LightClusterer();
+
+    LightClusterer(const LightClusterer&) = delete;
+    LightClusterer& operator=(const LightClusterer&) = delete;
+
+    // Depth range covered by the slices. Everything closer than nearZ falls into slice 0,
+    // so nearZ is usually larger than the camera near plane to avoid wasting slices.
+    void SetDepthRange(float nearZ, float farZ);
+
+    // Assigns lights to clusters for this camera and uploads the grid and index list.
+    // projection must be a symmetric perspective projection.
+    void Build(const std::vector<PointLight>& lights, float intensityScale,
+               const glm::mat4& view, const glm::mat4& projection);
+
+    // Binds the grid and index texture buffers to their texture units.
+    void Bind() const;
+
+    // slice = log(depth) * scale + bias (same mapping in scene_lighting.fs)
+    float GetSliceScale() const { return sliceScale; }
+    float GetSliceBias() const { return sliceBias; }
+
+    // Stats of the last Build()
+    size_t GetIndexCount() const { return indexCount; }
+    uint32_t GetMaxLightsPerCluster() const { return maxLightsPerCluster; }
+    uint32_t GetOccupiedClusterCount() const { return occupiedClusters; }
+    double GetLastBuildMs() const { return lastBuildMs; }
+
+private:
+    // Cluster range touched by one light (inclusive bounds)
+    struct LightRange
+    {
+        uint32_t light;
+        uint8_t x0, x1, y0, y1, z0, z1;
+    };
+
+    uint32_t SliceForDepth(float depth) const;
+
+    float nearZ = 0.5f;
+    float farZ = 100.0f;
+    float sliceScale = 0.0f;
+    float sliceBias = 0.0f;
+
+    // CPU staging, reused every frame
+    std::vector<LightRange> ranges;
+    std::vector<uint32_t> counts;  // per cluster
+    std::vector<uint32_t> grid;    // per cluster: offset, count
+    std::vector<uint32_t> indices;
+
+    GLuint gridBuffer = 0;
+    GLuint gridTexture = 0;
+    GLuint indexBuffer = 0;
+    GLuint indexTexture = 0;
+    size_t indexCapacity = 0;  // allocated size of indexBuffer, in indices
+    size_t maxIndices = 0;     // GL_MAX_TEXTURE_BUFFER_SIZE
+
+    size_t indexCount = 0;
+    uint32_t maxLightsPerCluster = 0;
+    uint32_t occupiedClusters = 0;
+    double lastBuildMs = 0.0;
+};
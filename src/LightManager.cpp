@@ -0,0 +1,166 @@
+#include "LightManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+size_t LightManager::QueryMaxLights()
+{
+    GLint maxBlockSize = 0;
+    glGetIntegerv(GL_MAX_UNIFORM_BLOCK_SIZE, &maxBlockSize);
+    // GL guarantees at least 16 KB per uniform block
+    maxBlockSize = std::max<GLint>(maxBlockSize, 16384);
+    return (static_cast<size_t>(maxBlockSize) - kHeaderSize) / sizeof(PointLight);
+}
+
+float LightManager::ComputeRadius(float intensity)
+{
+    // Solve intensity / (1 + 0.2d + 0.15d^2) = kAttenuationCutoff for d
+    const float k = std::max(intensity, 0.0f) / kAttenuationCutoff;
+    if (k <= 1.0f) return 0.0f;
+    return (-0.2f + std::sqrt(0.04f + 0.6f * (k - 1.0f))) / 0.3f;
+}
+
+LightManager::LightManager(size_t capacity)
+    : capacity(capacity),
+      uniformCapacity(std::min(capacity, QueryMaxLights()))
+{
+    lights.reserve(capacity);
+
+    // Allocate the whole block once: the bound range must cover the block size
+    // the shader was compiled with, even when only a few lights are in use.
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, kHeaderSize + uniformCapacity * sizeof(PointLight), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glGenBuffers(1, &lightBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, lightBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, std::max<size_t>(capacity, 1) * sizeof(PointLight), nullptr, GL_DYNAMIC_DRAW);
+    glGenTextures(1, &lightTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, lightBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+    glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+LightManager::~LightManager()
+{
+    if (lightTexture != 0)
+        glDeleteTextures(1, &lightTexture);
+    if (lightBuffer != 0)
+        glDeleteBuffers(1, &lightBuffer);
+    if (ubo != 0)
+        glDeleteBuffers(1, &ubo);
+}
+
+size_t LightManager::Add(const PointLight& light)
+{
+    if (lights.size() >= capacity) return capacity;
+
+    lights.push_back(light);
+    lights.back().radius = ComputeRadius(light.intensity);
+    const size_t index = lights.size() - 1;
+    MarkDirty(index);
+    headerDirty = true; // count changed
+    return index;
+}
+
+void LightManager::Set(size_t index, const PointLight& light)
+{
+    if (index >= lights.size()) return;
+
+    PointLight updated = light;
+    updated.radius = ComputeRadius(light.intensity);
+    if (std::memcmp(&lights[index], &updated, sizeof(PointLight)) == 0) return;
+
+    lights[index] = updated;
+    MarkDirty(index);
+}
+
+void LightManager::Clear()
+{
+    if (lights.empty()) return;
+    lights.clear();
+    dirtyBegin = dirtyEnd = 0;
+    headerDirty = true;
+}
+
+void LightManager::SetIntensityScale(float scale)
+{
+    if (scale == intensityScale) return;
+    intensityScale = scale;
+    headerDirty = true;
+}
+
+void LightManager::MarkDirty(size_t index)
+{
+    if (dirtyBegin == dirtyEnd)
+    {
+        dirtyBegin = index;
+        dirtyEnd = index + 1;
+    }
+    else
+    {
+        dirtyBegin = std::min(dirtyBegin, index);
+        dirtyEnd = std::max(dirtyEnd, index + 1);
+    }
+}
+
+size_t LightManager::Upload()
+{
+    lastUploadBytes = 0;
+    if (!headerDirty && dirtyBegin == dirtyEnd) return 0;
+
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+
+    if (headerDirty)
+    {
+        struct Header
+        {
+            int32_t numPointLights;
+            float pointLightScale;
+            float padding[2];
+        } header = { static_cast<int32_t>(std::min(lights.size(), uniformCapacity)), intensityScale, { 0.0f, 0.0f } };
+        static_assert(sizeof(Header) == kHeaderSize, "Header must match the std140 layout");
+
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, kHeaderSize, &header);
+        lastUploadBytes += kHeaderSize;
+        headerDirty = false;
+    }
+
+    dirtyEnd = std::min(dirtyEnd, lights.size());
+
+    // Uniform block: only the part of the dirty range that fits in the block
+    const size_t uniformEnd = std::min(dirtyEnd, uniformCapacity);
+    if (dirtyBegin < uniformEnd)
+    {
+        const size_t bytes = (uniformEnd - dirtyBegin) * sizeof(PointLight);
+        glBufferSubData(GL_UNIFORM_BUFFER, kHeaderSize + dirtyBegin * sizeof(PointLight), bytes, &lights[dirtyBegin]);
+        lastUploadBytes += bytes;
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    // Texture buffer: the whole dirty range
+    if (dirtyBegin < dirtyEnd)
+    {
+        const size_t bytes = (dirtyEnd - dirtyBegin) * sizeof(PointLight);
+        glBindBuffer(GL_TEXTURE_BUFFER, lightBuffer);
+        glBufferSubData(GL_TEXTURE_BUFFER, dirtyBegin * sizeof(PointLight), bytes, &lights[dirtyBegin]);
+        glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        lastUploadBytes += bytes;
+    }
+    dirtyBegin = dirtyEnd = 0;
+
+    return lastUploadBytes;
+}
+
+void LightManager::Bind() const
+{
+    glBindBufferBase(GL_UNIFORM_BUFFER, kBindingPoint, ubo);
+
+    glActiveTexture(GL_TEXTURE0 + kLightTextureUnit);
+    glBindTexture(GL_TEXTURE_BUFFER, lightTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <vector>
+
+// One point light exactly as laid out in the std140 PointLightBlock (32 bytes):
+// vec3 position + float intensity share one 16-byte slot, vec3 color + radius the next.
+// The same two vec4s per light are also stored in the light texture buffer.
+struct PointLight
+{
+    glm::vec3 position = glm::vec3(0.0f);
+    float intensity = 0.0f;
+    glm::vec3 color = glm::vec3(1.0f);
+    float radius = 0.0f; // filled in by LightManager (see ComputeRadius)
+};
+static_assert(sizeof(PointLight) == 32, "PointLight must match the std140 layout");
+
+// Owns the point lights and the uniform buffer backing scene_lighting.fs's PointLightBlock:
+//   layout(std140) uniform PointLightBlock {
+//       int numPointLights; float pointLightScale; PointLight pointLights[MAX_POINT_LIGHTS];
+//   };
+// Changes are tracked so Upload() only sends the dirty header / dirty light range;
+// toggling or dimming all lights rewrites a single float instead of every light.
+// Every light is also mirrored into an RGBA32F texture buffer (2 texels per light), which is
+// not bound by the uniform block size limit and is what clustered shading reads from.
+// The uniform block only ever holds the first GetUniformCapacity() lights.
+class LightManager
+{
+public:
+    // Uniform block binding point shared with the shader (see Shader::BindUniformBlock).
+    static constexpr GLuint kBindingPoint = 0;
+    // Texture unit of the light texture buffer (pointLightData in scene_lighting.fs).
+    static constexpr GLuint kLightTextureUnit = 4;
+
+    // Attenuated intensity below which a light is treated as having no influence;
+    // the shader fades each light smoothly to zero at its radius.
+    static constexpr float kAttenuationCutoff = 0.05f;
+
+    // Distance at which intensity / (1 + 0.2d + 0.15d^2) (scene_lighting.fs attenuation)
+    // falls to kAttenuationCutoff.
+    static float ComputeRadius(float intensity);
+
+    // Largest light count that fits in a uniform block on this driver (GL context required).
+    static size_t QueryMaxLights();
+
+    // capacity is the total number of lights; the uniform block holds as many as the driver allows.
+    explicit LightManager(size_t capacity);
+    ~LightManager();
+
+    LightManager(const LightManager&) = delete;
+    LightManager& operator=(const LightManager&) = delete;
+
+    // Appends a light; returns its index (or Capacity() if full, in which case it is dropped).
+    size_t Add(const PointLight& light);
+
+    // Replaces a light; only marks it dirty if something actually changed.
+    void Set(size_t index, const PointLight& light);
+    const PointLight& Get(size_t index) const { return lights[index]; }
+
+    void Clear();
+
+    // Global intensity multiplier (light switch * brightness), applied in the shader.
+    void SetIntensityScale(float scale);
+    float GetIntensityScale() const { return intensityScale; }
+
+    size_t Size() const { return lights.size(); }
+    size_t Capacity() const { return capacity; }
+    size_t GetUniformCapacity() const { return uniformCapacity; }
+    const std::vector<PointLight>& GetLights() const { return lights; }
+
+    // Sends pending changes to the GPU; returns the number of bytes uploaded.
+    size_t Upload();
+
+    // Binds the uniform buffer to kBindingPoint and the light texture buffer to kLightTextureUnit.
+    void Bind() const;
+
+    size_t GetLastUploadBytes() const { return lastUploadBytes; }
+
+private:
+    static constexpr size_t kHeaderSize = 16; // int count + float scale, padded to the array alignment
+
+    void MarkDirty(size_t index);
+
+    GLuint ubo = 0;
+    GLuint lightBuffer = 0;  // texture buffer storage (all lights, no header)
+    GLuint lightTexture = 0;
+    size_t capacity = 0;
+    size_t uniformCapacity = 0;
+    std::vector<PointLight> lights;
+    float intensityScale = 1.0f;
+
+    bool headerDirty = true;
+    size_t dirtyBegin = 0; // [dirtyBegin, dirtyEnd) lights awaiting upload
+    size_t dirtyEnd = 0;
+    size_t lastUploadBytes = 0;
+};
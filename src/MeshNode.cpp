@@ -0,0 +1,48 @@
+#include "MeshNode.h"
+
+MeshTable& MeshTable::Get()
+{
+    // Never destroyed, like the SceneArena: static node handles may release meshes during exit
+    static MeshTable* table = new MeshTable();
+    return *table;
+}
+
+uint32_t MeshTable::Add(MeshType type)
+{
+    if (!freeIds.empty())
+    {
+        const uint32_t id = freeIds.back();
+        freeIds.pop_back();
+        types[id] = type;
+        materials[id] = Material{};
+        occluders[id] = 0;
+        return id;
+    }
+
+    types.push_back(type);
+    materials.push_back(Material{});
+    occluders.push_back(0);
+    return static_cast<uint32_t>(types.size() - 1);
+}
+
+void MeshTable::Remove(uint32_t id)
+{
+    freeIds.push_back(id);
+}
+
+MeshNode::MeshNode(MeshType type)
+    : SceneNode(kKind, glm::mat4(1.0f)),
+      meshId(MeshTable::Get().Add(type))
+{
+}
+
+MeshNode::MeshNode(const glm::mat4& local, MeshType type)
+    : SceneNode(kKind, local),
+      meshId(MeshTable::Get().Add(type))
+{
+}
+
+MeshNode::~MeshNode()
+{
+    MeshTable::Get().Remove(meshId);
+}
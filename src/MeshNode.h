@@ -0,0 +1,99 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "SceneNode.h"
+
+// Small helper types used by SchoolBuilder
+struct Material
+{
+    glm::vec3 albedo = glm::vec3(1.0f);
+};
+
+enum class MeshType : uint8_t
+{
+    Cube,
+    Plane,
+    Pyramid,
+    Cylinder,
+    Cone,
+    Sphere
+};
+
+// Mesh and material data of every MeshNode, kept out of the nodes in parallel arrays indexed by
+// the node's mesh id. Flat traversals (TransformHierarchy::ForEachMesh) read these arrays without
+// touching the node objects. Ids of destroyed nodes are reused.
+class MeshTable
+{
+public:
+    static constexpr uint32_t kNoMesh = 0xFFFFFFFFu;
+
+    // The table used by every MeshNode
+    static MeshTable& Get();
+
+    MeshTable(const MeshTable&) = delete;
+    MeshTable& operator=(const MeshTable&) = delete;
+
+    uint32_t Add(MeshType type);
+    void Remove(uint32_t id);
+
+    MeshType GetType(uint32_t id) const { return types[id]; }
+    const Material& GetMaterial(uint32_t id) const { return materials[id]; }
+    bool IsOccluder(uint32_t id) const { return occluders[id] != 0; }
+
+    void SetMaterial(uint32_t id, const Material& material) { materials[id] = material; }
+    void SetOccluder(uint32_t id, bool occluder) { occluders[id] = occluder ? 1 : 0; }
+
+    // Live meshes
+    size_t Size() const { return types.size() - freeIds.size(); }
+
+private:
+    MeshTable() = default;
+
+    std::vector<MeshType> types;
+    std::vector<Material> materials;
+    std::vector<uint8_t> occluders; // rasterized into the occlusion buffer (wing walls, floors, roofs)
+    std::vector<uint32_t> freeIds;
+};
+
+// A SceneNode subclass that draws one primitive with a basic material.
+// Rendering code finds it through the kind tag (NodeCast<MeshNode>); its mesh type and material
+// live in the MeshTable under GetMeshId().
+class MeshNode : public SceneNode
+{
+public:
+    static constexpr NodeKind kKind = NodeKind::Mesh;
+    using Ptr = NodeRef<MeshNode>;
+
+    explicit MeshNode(MeshType type = MeshType::Cube);
+    MeshNode(const glm::mat4& local, MeshType type = MeshType::Cube);
+    ~MeshNode() override;
+
+    // All primitives fit the unit cube around the origin; planes are flat
+    bool GetLocalBounds(AABB& out) const override
+    {
+        out.min = glm::vec3(-0.5f);
+        out.max = glm::vec3(0.5f);
+        if (GetMeshType() == MeshType::Plane)
+        {
+            out.min.y = 0.0f;
+            out.max.y = 0.0f;
+        }
+        return true;
+    }
+
+    uint32_t GetMeshId() const { return meshId; }
+
+    MeshType GetMeshType() const { return MeshTable::Get().GetType(meshId); }
+    const Material& GetMaterial() const { return MeshTable::Get().GetMaterial(meshId); }
+    void SetAlbedo(const glm::vec3& albedo) { MeshTable::Get().SetMaterial(meshId, Material{ albedo }); }
+
+    // Large solid piece (wing walls, floors, roof) rasterized into the occlusion buffer
+    bool IsOccluder() const { return MeshTable::Get().IsOccluder(meshId); }
+    void SetOccluder(bool occluder) { MeshTable::Get().SetOccluder(meshId, occluder); }
+
+private:
+    uint32_t meshId;
+};
@@ -0,0 +1,361 @@
+#include "OcclusionCuller.h"
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define OCCLUSION_CULLER_SSE2 1
+#endif
+
+namespace
+{
+    // Box corner i has x from bit 0, y from bit 1, z from bit 2 (0 = min, 1 = max).
+    // Faces are wound counter-clockwise seen from outside.
+    constexpr uint8_t kBoxTriangles[12][3] = {
+        { 0, 4, 6 }, { 0, 6, 2 }, // -X
+        { 1, 3, 7 }, { 1, 7, 5 }, // +X
+        { 0, 1, 5 }, { 0, 5, 4 }, // -Y
+        { 2, 6, 7 }, { 2, 7, 3 }, // +Y
+        { 0, 2, 3 }, { 0, 3, 1 }, // -Z
+        { 4, 5, 7 }, { 4, 7, 6 }, // +Z
+    };
+
+    // Distance over which the debug view fades from white (at the camera) to black
+    constexpr float kDebugDepthRange = 100.0f;
+
+    void BoxCorners(const AABB& box, const glm::mat4& m, glm::vec4 (&out)[8])
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            const glm::vec3 p((i & 1) ? box.max.x : box.min.x,
+                              (i & 2) ? box.max.y : box.min.y,
+                              (i & 4) ? box.max.z : box.min.z);
+            out[i] = m * glm::vec4(p, 1.0f);
+        }
+    }
+
+    // True if all corners are outside the same clip plane
+    bool OutsideClipVolume(const glm::vec4 (&c)[8])
+    {
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            bool allBelow = true;
+            bool allAbove = true;
+            for (const glm::vec4& v : c)
+            {
+                allBelow = allBelow && v[axis] < -v.w;
+                allAbove = allAbove && v[axis] > v.w;
+            }
+            if (allBelow || allAbove) return true;
+        }
+        return false;
+    }
+}
+
+OcclusionCuller::OcclusionCuller()
+    : depth(static_cast<size_t>(kWidth) * kHeight, 0.0f),
+      blockFarthest(static_cast<size_t>(kBlocksX) * kBlocksY, 0.0f),
+      tileBins(static_cast<size_t>(kTilesX) * kTilesY)
+{
+}
+
+void OcclusionCuller::SetOccluders(std::vector<const SceneNode*> nodes)
+{
+    occluders = std::move(nodes);
+}
+
+void OcclusionCuller::Render(const glm::mat4& newViewProjection, JobSystem* jobs)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    viewProjection = newViewProjection;
+    std::fill(depth.begin(), depth.end(), 0.0f);
+    triangles.clear();
+    for (auto& bin : tileBins)
+        bin.clear();
+
+    // 1. Transform, clip and bin the occluder boxes' front faces
+    renderedOccluders = 0;
+    for (const SceneNode* node : occluders)
+    {
+        AABB local;
+        if (!node->GetLocalBounds(local)) continue;
+
+        const glm::mat4 model = node->GetGlobalTransform();
+        glm::vec4 clip[8];
+        BoxCorners(local, viewProjection * model, clip);
+        if (OutsideClipVolume(clip)) continue;
+
+        // A mirroring transform turns the outward faces clockwise
+        const bool flipWinding = glm::determinant(glm::mat3(model)) < 0.0f;
+        for (const auto& tri : kBoxTriangles)
+            AddClippedTriangle(clip[tri[0]], clip[tri[1]], clip[tri[2]], flipWinding);
+        ++renderedOccluders;
+    }
+
+    // 2. Rasterize the tiles (each tile only touches its own pixels and blocks)
+    constexpr size_t tileCount = static_cast<size_t>(kTilesX) * kTilesY;
+    if (jobs)
+    {
+        jobs->ParallelFor(tileCount, 1, [this](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t)
+                RasterizeTile(static_cast<int>(t));
+        });
+    }
+    else
+    {
+        for (size_t t = 0; t < tileCount; ++t)
+            RasterizeTile(static_cast<int>(t));
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    lastRenderMs = std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+void OcclusionCuller::AddClippedTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c, bool flipWinding)
+{
+    // Near plane in GL clip space: z + w >= 0
+    const float da = a.z + a.w;
+    const float db = b.z + b.w;
+    const float dc = c.z + c.w;
+
+    if (da >= 0.0f && db >= 0.0f && dc >= 0.0f)
+    {
+        const glm::vec4 v[3] = { a, b, c };
+        AddScreenTriangle(v, flipWinding);
+        return;
+    }
+    if (da < 0.0f && db < 0.0f && dc < 0.0f) return;
+
+    // Sutherland-Hodgman against the near plane: one triangle in, at most a quad out
+    const glm::vec4 in[3] = { a, b, c };
+    const float d[3] = { da, db, dc };
+    glm::vec4 poly[4];
+    int count = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        const int j = (i + 1) % 3;
+        if (d[i] >= 0.0f) poly[count++] = in[i];
+        if ((d[i] >= 0.0f) != (d[j] >= 0.0f))
+        {
+            const float t = d[i] / (d[i] - d[j]);
+            poly[count++] = in[i] + (in[j] - in[i]) * t;
+        }
+    }
+
+    for (int i = 1; i + 1 < count; ++i)
+    {
+        const glm::vec4 v[3] = { poly[0], poly[i], poly[i + 1] };
+        AddScreenTriangle(v, flipWinding);
+    }
+}
+
+void OcclusionCuller::AddScreenTriangle(const glm::vec4 (&v)[3], bool flipWinding)
+{
+    Triangle tri;
+    for (int k = 0; k < 3; ++k)
+    {
+        const float invW = 1.0f / v[k].w;
+        tri.x[k] = (v[k].x * invW * 0.5f + 0.5f) * static_cast<float>(kWidth);
+        tri.y[k] = (v[k].y * invW * 0.5f + 0.5f) * static_cast<float>(kHeight);
+        tri.z[k] = invW;
+    }
+
+    // Keep front faces only (counter-clockwise on screen, or clockwise under a mirroring transform)
+    const float area = (tri.x[1] - tri.x[0]) * (tri.y[2] - tri.y[0]) - (tri.x[2] - tri.x[0]) * (tri.y[1] - tri.y[0]);
+    const bool front = flipWinding ? area < 0.0f : area > 0.0f;
+    if (!front) return;
+    if (area < 0.0f)
+    {
+        std::swap(tri.x[1], tri.x[2]);
+        std::swap(tri.y[1], tri.y[2]);
+        std::swap(tri.z[1], tri.z[2]);
+    }
+
+    const float minX = std::min({ tri.x[0], tri.x[1], tri.x[2] });
+    const float maxX = std::max({ tri.x[0], tri.x[1], tri.x[2] });
+    const float minY = std::min({ tri.y[0], tri.y[1], tri.y[2] });
+    const float maxY = std::max({ tri.y[0], tri.y[1], tri.y[2] });
+    if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(kWidth) || minY >= static_cast<float>(kHeight)) return;
+
+    const int tx0 = std::clamp(static_cast<int>(minX) / kTileWidth, 0, kTilesX - 1);
+    const int tx1 = std::clamp(static_cast<int>(maxX) / kTileWidth, 0, kTilesX - 1);
+    const int ty0 = std::clamp(static_cast<int>(minY) / kTileHeight, 0, kTilesY - 1);
+    const int ty1 = std::clamp(static_cast<int>(maxY) / kTileHeight, 0, kTilesY - 1);
+
+    const uint32_t index = static_cast<uint32_t>(triangles.size());
+    triangles.push_back(tri);
+    for (int ty = ty0; ty <= ty1; ++ty)
+        for (int tx = tx0; tx <= tx1; ++tx)
+            tileBins[static_cast<size_t>(ty * kTilesX + tx)].push_back(index);
+}
+
+void OcclusionCuller::RasterizeTile(int tile)
+{
+    const int tileX0 = (tile % kTilesX) * kTileWidth;
+    const int tileY0 = (tile / kTilesX) * kTileHeight;
+    const int tileX1 = tileX0 + kTileWidth - 1;
+    const int tileY1 = tileY0 + kTileHeight - 1;
+
+    for (uint32_t index : tileBins[static_cast<size_t>(tile)])
+    {
+        const Triangle& t = triangles[index];
+
+        // Edge k runs from vertex k to k + 1: E(x, y) = a*x + b*y + c, >= 0 inside (counter-clockwise)
+        float ea[3], eb[3], ec[3];
+        for (int k = 0; k < 3; ++k)
+        {
+            const int n = (k + 1) % 3;
+            ea[k] = t.y[k] - t.y[n];
+            eb[k] = t.x[n] - t.x[k];
+            ec[k] = -(ea[k] * t.x[k] + eb[k] * t.y[k]);
+        }
+
+        // Depth plane through the three vertices
+        const float area = (t.x[1] - t.x[0]) * (t.y[2] - t.y[0]) - (t.x[2] - t.x[0]) * (t.y[1] - t.y[0]);
+        const float invArea = 1.0f / area;
+        const float dzdx = ((t.z[1] - t.z[0]) * (t.y[2] - t.y[0]) - (t.z[2] - t.z[0]) * (t.y[1] - t.y[0])) * invArea;
+        const float dzdy = ((t.z[2] - t.z[0]) * (t.x[1] - t.x[0]) - (t.z[1] - t.z[0]) * (t.x[2] - t.x[0])) * invArea;
+        const float z0 = t.z[0] - dzdx * t.x[0] - dzdy * t.y[0]; // depth at (0, 0)
+
+        // Pixel range inside this tile (x aligned down to 4 for the SIMD loop)
+        int minX = std::max(tileX0, static_cast<int>(std::floor(std::min({ t.x[0], t.x[1], t.x[2] }))));
+        const int maxX = std::min(tileX1, static_cast<int>(std::ceil(std::max({ t.x[0], t.x[1], t.x[2] }))));
+        const int minY = std::max(tileY0, static_cast<int>(std::floor(std::min({ t.y[0], t.y[1], t.y[2] }))));
+        const int maxY = std::min(tileY1, static_cast<int>(std::ceil(std::max({ t.y[0], t.y[1], t.y[2] }))));
+        if (minX > maxX || minY > maxY) continue;
+        minX &= ~3;
+
+        for (int py = minY; py <= maxY; ++py)
+        {
+            const float fy = static_cast<float>(py) + 0.5f;
+            float* row = &depth[static_cast<size_t>(py) * kWidth];
+
+#if defined(OCCLUSION_CULLER_SSE2)
+            const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+            const __m128 zero = _mm_setzero_ps();
+            const __m128 rowZ = _mm_set1_ps(z0 + dzdy * fy);
+            const __m128 dz = _mm_set1_ps(dzdx);
+            __m128 rowE[3], stepA[3];
+            for (int k = 0; k < 3; ++k)
+            {
+                rowE[k] = _mm_set1_ps(eb[k] * fy + ec[k]);
+                stepA[k] = _mm_set1_ps(ea[k]);
+            }
+
+            for (int px = minX; px <= maxX; px += 4)
+            {
+                const __m128 fx = _mm_add_ps(_mm_set1_ps(static_cast<float>(px)), laneOffsets);
+                const __m128 e0 = _mm_add_ps(_mm_mul_ps(stepA[0], fx), rowE[0]);
+                const __m128 e1 = _mm_add_ps(_mm_mul_ps(stepA[1], fx), rowE[1]);
+                const __m128 e2 = _mm_add_ps(_mm_mul_ps(stepA[2], fx), rowE[2]);
+                const __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)),
+                                                 _mm_cmpge_ps(e2, zero));
+                if (_mm_movemask_ps(inside) == 0) continue;
+
+                const __m128 z = _mm_add_ps(rowZ, _mm_mul_ps(dz, fx));
+                const __m128 old = _mm_loadu_ps(row + px);
+                const __m128 closer = _mm_max_ps(old, z);
+                _mm_storeu_ps(row + px, _mm_or_ps(_mm_and_ps(inside, closer), _mm_andnot_ps(inside, old)));
+            }
+#else
+            for (int px = minX; px <= maxX; ++px)
+            {
+                const float fx = static_cast<float>(px) + 0.5f;
+                if (ea[0] * fx + eb[0] * fy + ec[0] < 0.0f) continue;
+                if (ea[1] * fx + eb[1] * fy + ec[1] < 0.0f) continue;
+                if (ea[2] * fx + eb[2] * fy + ec[2] < 0.0f) continue;
+                row[px] = std::max(row[px], z0 + dzdx * fx + dzdy * fy);
+            }
+#endif
+        }
+    }
+
+    // Coarse level: farthest depth of every block in this tile
+    for (int by = tileY0 / kBlockSize; by <= tileY1 / kBlockSize; ++by)
+    {
+        for (int bx = tileX0 / kBlockSize; bx <= tileX1 / kBlockSize; ++bx)
+        {
+            float farthest = FLT_MAX;
+            for (int y = by * kBlockSize; y < (by + 1) * kBlockSize; ++y)
+            {
+                const float* row = &depth[static_cast<size_t>(y) * kWidth + bx * kBlockSize];
+                for (int x = 0; x < kBlockSize; ++x)
+                    farthest = std::min(farthest, row[x]);
+            }
+            blockFarthest[static_cast<size_t>(by) * kBlocksX + bx] = farthest;
+        }
+    }
+}
+
+bool OcclusionCuller::IsOccluded(const AABB& box) const
+{
+    glm::vec4 clip[8];
+    BoxCorners(box, viewProjection, clip);
+
+    // Screen rectangle and closest depth of the box (1/w is largest at the nearest corner)
+    float minX = FLT_MAX, maxX = -FLT_MAX, minY = FLT_MAX, maxY = -FLT_MAX;
+    float nearest = 0.0f;
+    for (const glm::vec4& c : clip)
+    {
+        if (c.z < -c.w || c.w <= 0.0f) return false; // crosses the near plane
+
+        const float invW = 1.0f / c.w;
+        const float x = (c.x * invW * 0.5f + 0.5f) * static_cast<float>(kWidth);
+        const float y = (c.y * invW * 0.5f + 0.5f) * static_cast<float>(kHeight);
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+        nearest = std::max(nearest, invW);
+    }
+
+    // Every pixel the rectangle touches must hold a closer occluder
+    const int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+    const int x1 = std::min(kWidth - 1, static_cast<int>(std::floor(maxX)));
+    const int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+    const int y1 = std::min(kHeight - 1, static_cast<int>(std::floor(maxY)));
+    if (x0 > x1 || y0 > y1) return false;
+
+    for (int by = y0 / kBlockSize; by <= y1 / kBlockSize; ++by)
+    {
+        for (int bx = x0 / kBlockSize; bx <= x1 / kBlockSize; ++bx)
+        {
+            if (blockFarthest[static_cast<size_t>(by) * kBlocksX + bx] > nearest) continue;
+
+            // Block not entirely in front: check the covered pixels
+            const int px0 = std::max(x0, bx * kBlockSize), px1 = std::min(x1, bx * kBlockSize + kBlockSize - 1);
+            const int py0 = std::max(y0, by * kBlockSize), py1 = std::min(y1, by * kBlockSize + kBlockSize - 1);
+            for (int y = py0; y <= py1; ++y)
+            {
+                const float* row = &depth[static_cast<size_t>(y) * kWidth];
+                for (int x = px0; x <= px1; ++x)
+                {
+                    if (row[x] <= nearest) return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void OcclusionCuller::GetDebugImage(std::vector<uint8_t>& rgba) const
+{
+    rgba.resize(depth.size() * 4);
+    for (size_t i = 0; i < depth.size(); ++i)
+    {
+        float brightness = 0.0f;
+        if (depth[i] > 0.0f)
+            brightness = std::clamp(1.0f - (1.0f / depth[i]) / kDebugDepthRange, 0.0f, 1.0f);
+
+        const uint8_t v = static_cast<uint8_t>(brightness * 255.0f + 0.5f);
+        rgba[i * 4 + 0] = v;
+        rgba[i * 4 + 1] = v;
+        rgba[i * 4 + 2] = v;
+        rgba[i * 4 + 3] = 255;
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Collision.h"
+#include "SceneNode.h"
+
+class JobSystem;
+
+// Software occlusion culling: the boxes of a few large occluders (wing walls, floors, roofs)
+// are rasterized on the CPU into a small depth buffer, then object bounds are tested against it
+// before their draws are submitted.
+// - Depth is stored as 1/w (larger = closer, 0 = nothing drawn), which interpolates linearly in
+//   screen space. Occluders keep the closest value per pixel.
+// - Triangles are clipped against the near plane, binned into kTilesX x kTilesY screen tiles
+//   and each tile is rasterized independently (4 pixels at a time with SSE2), optionally on the
+//   job system's workers.
+// - A coarse level stores the farthest depth of every kBlockSize x kBlockSize block, so most
+//   IsOccluded() calls only look at a handful of block values.
+class OcclusionCuller
+{
+public:
+    static constexpr int kWidth = 256;
+    static constexpr int kHeight = 128;
+    static constexpr int kTileWidth = 32;
+    static constexpr int kTileHeight = 32;
+    static constexpr int kTilesX = kWidth / kTileWidth;
+    static constexpr int kTilesY = kHeight / kTileHeight;
+    static constexpr int kBlockSize = 8;
+    static constexpr int kBlocksX = kWidth / kBlockSize;
+    static constexpr int kBlocksY = kHeight / kBlockSize;
+
+    OcclusionCuller();
+
+    // Nodes whose local bounds (GetLocalBounds, under their current global transform) are drawn
+    // as solid boxes into the depth buffer. The nodes must outlive the culler.
+    void SetOccluders(std::vector<const SceneNode*> nodes);
+
+    // Rasterizes the occluders for this camera and rebuilds the coarse level.
+    // jobs may be null to rasterize every tile on the calling thread.
+    void Render(const glm::mat4& viewProjection, JobSystem* jobs = nullptr);
+
+    // True if box is certainly hidden behind the occluders of the last Render().
+    // Boxes crossing the near plane or leaving the screen are reported visible.
+    bool IsOccluded(const AABB& box) const;
+
+    // Depth buffer as RGBA8 grey levels (closer = brighter), kWidth x kHeight, bottom row first.
+    void GetDebugImage(std::vector<uint8_t>& rgba) const;
+
+    // Stats of the last Render()
+    size_t GetOccluderCount() const { return occluders.size(); }
+    size_t GetRenderedOccluderCount() const { return renderedOccluders; }
+    size_t GetTriangleCount() const { return triangles.size(); }
+    double GetLastRenderMs() const { return lastRenderMs; }
+
+private:
+    // Screen-space triangle, counter-clockwise; z = 1/w
+    struct Triangle
+    {
+        float x[3];
+        float y[3];
+        float z[3];
+    };
+
+    void AddClippedTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c, bool flipWinding);
+    void AddScreenTriangle(const glm::vec4 (&v)[3], bool flipWinding);
+    void RasterizeTile(int tile);
+
+    std::vector<const SceneNode*> occluders;
+
+    std::vector<float> depth;        // kWidth * kHeight, row 0 at the bottom
+    std::vector<float> blockFarthest; // kBlocksX * kBlocksY, min of depth over each block
+
+    std::vector<Triangle> triangles;
+    std::vector<std::vector<uint32_t>> tileBins; // triangle indices per tile
+
+    glm::mat4 viewProjection = glm::mat4(1.0f);
+    size_t renderedOccluders = 0;
+    double lastRenderMs = 0.0;
+};
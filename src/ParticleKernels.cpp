@@ -0,0 +1,327 @@
+#include "ParticleKernels.h"
+#include "ColliderGrid.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+    #define PARTICLE_KERNELS_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define PARTICLE_KERNELS_SSE2 1
+#endif
+
+void ParticleSoA::Resize(size_t count)
+{
+    for (std::vector<float>* v : { &posX, &posY, &posZ, &velX, &velY, &velZ, &colR, &colG, &colB, &colA })
+        v->resize(count, 0.0f);
+    life.resize(count, 0.0f);
+    floorY.resize(count, -FLT_MAX);
+    gravityScale.resize(count, 1.0f);
+    size.resize(count, 10.0f);
+}
+
+void ParticleSoA::Set(size_t i, const glm::vec3& position, const glm::vec3& velocity, const glm::vec4& color, float lifetime,
+                      float floor, float gravityMultiplier, float pointSize)
+{
+    posX[i] = position.x; posY[i] = position.y; posZ[i] = position.z;
+    velX[i] = velocity.x; velY[i] = velocity.y; velZ[i] = velocity.z;
+    colR[i] = color.r; colG[i] = color.g; colB[i] = color.b; colA[i] = color.a;
+    life[i] = lifetime;
+    floorY[i] = floor;
+    gravityScale[i] = gravityMultiplier;
+    size[i] = pointSize;
+}
+
+void ParticleSoA::Copy(size_t dst, size_t src)
+{
+    posX[dst] = posX[src]; posY[dst] = posY[src]; posZ[dst] = posZ[src];
+    velX[dst] = velX[src]; velY[dst] = velY[src]; velZ[dst] = velZ[src];
+    colR[dst] = colR[src]; colG[dst] = colG[src]; colB[dst] = colB[src]; colA[dst] = colA[src];
+    life[dst] = life[src];
+    floorY[dst] = floorY[src];
+    gravityScale[dst] = gravityScale[src];
+    size[dst] = size[src];
+}
+
+namespace
+{
+    // Scalar loop over [begin, end): also handles the tail the SIMD loops leave over
+    void IntegrateScalarRange(ParticleSoA& p, size_t begin, size_t end, const ParticleIntegrateParams& params)
+    {
+        const float dt = params.dt;
+        const glm::vec3 gdt = params.gravity * dt;
+        const float fade = params.fadeRate * dt;
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            p.life[i] -= dt;
+
+            const float g = p.gravityScale[i];
+            p.velX[i] += gdt.x * g;
+            p.velY[i] += gdt.y * g;
+            p.velZ[i] += gdt.z * g;
+            p.posX[i] += p.velX[i] * dt;
+            p.posY[i] += p.velY[i] * dt;
+            p.posZ[i] += p.velZ[i] * dt;
+            p.colA[i] -= fade;
+
+            if (p.posY[i] < p.floorY[i])
+            {
+                p.posY[i] = p.floorY[i];
+                p.velY[i] = -p.velY[i] * params.bounce;
+                p.velX[i] *= params.friction;
+                p.velZ[i] *= params.friction;
+            }
+        }
+    }
+}
+
+namespace ParticleKernels
+{
+    void IntegrateScalar(ParticleSoA& particles, size_t count, const ParticleIntegrateParams& params)
+    {
+        IntegrateScalarRange(particles, 0, count, params);
+    }
+
+    void Integrate(ParticleSoA& particles, size_t count, const ParticleIntegrateParams& params)
+    {
+        Integrate(particles, 0, count, params);
+    }
+
+    void Integrate(ParticleSoA& p, size_t begin, size_t end, const ParticleIntegrateParams& params)
+    {
+        size_t i = begin;
+
+#if defined(PARTICLE_KERNELS_AVX2)
+        const __m256 dt = _mm256_set1_ps(params.dt);
+        const __m256 gx = _mm256_set1_ps(params.gravity.x * params.dt);
+        const __m256 gy = _mm256_set1_ps(params.gravity.y * params.dt);
+        const __m256 gz = _mm256_set1_ps(params.gravity.z * params.dt);
+        const __m256 fade = _mm256_set1_ps(params.fadeRate * params.dt);
+        const __m256 negBounce = _mm256_set1_ps(-params.bounce);
+        const __m256 friction = _mm256_set1_ps(params.friction);
+
+        for (; i + 8 <= end; i += 8)
+        {
+            _mm256_storeu_ps(&p.life[i], _mm256_sub_ps(_mm256_loadu_ps(&p.life[i]), dt));
+
+            const __m256 g = _mm256_loadu_ps(&p.gravityScale[i]);
+            __m256 vx = _mm256_add_ps(_mm256_loadu_ps(&p.velX[i]), _mm256_mul_ps(gx, g));
+            __m256 vy = _mm256_add_ps(_mm256_loadu_ps(&p.velY[i]), _mm256_mul_ps(gy, g));
+            __m256 vz = _mm256_add_ps(_mm256_loadu_ps(&p.velZ[i]), _mm256_mul_ps(gz, g));
+            const __m256 px = _mm256_add_ps(_mm256_loadu_ps(&p.posX[i]), _mm256_mul_ps(vx, dt));
+            __m256 py = _mm256_add_ps(_mm256_loadu_ps(&p.posY[i]), _mm256_mul_ps(vy, dt));
+            const __m256 pz = _mm256_add_ps(_mm256_loadu_ps(&p.posZ[i]), _mm256_mul_ps(vz, dt));
+            _mm256_storeu_ps(&p.colA[i], _mm256_sub_ps(_mm256_loadu_ps(&p.colA[i]), fade));
+
+            // Floor bounce, branch-free: blend the bounced values in where y < floor
+            const __m256 floorY = _mm256_loadu_ps(&p.floorY[i]);
+            const __m256 below = _mm256_cmp_ps(py, floorY, _CMP_LT_OQ);
+            py = _mm256_blendv_ps(py, floorY, below);
+            vy = _mm256_blendv_ps(vy, _mm256_mul_ps(vy, negBounce), below);
+            vx = _mm256_blendv_ps(vx, _mm256_mul_ps(vx, friction), below);
+            vz = _mm256_blendv_ps(vz, _mm256_mul_ps(vz, friction), below);
+
+            _mm256_storeu_ps(&p.posX[i], px);
+            _mm256_storeu_ps(&p.posY[i], py);
+            _mm256_storeu_ps(&p.posZ[i], pz);
+            _mm256_storeu_ps(&p.velX[i], vx);
+            _mm256_storeu_ps(&p.velY[i], vy);
+            _mm256_storeu_ps(&p.velZ[i], vz);
+        }
+#elif defined(PARTICLE_KERNELS_SSE2)
+        const __m128 dt = _mm_set1_ps(params.dt);
+        const __m128 gx = _mm_set1_ps(params.gravity.x * params.dt);
+        const __m128 gy = _mm_set1_ps(params.gravity.y * params.dt);
+        const __m128 gz = _mm_set1_ps(params.gravity.z * params.dt);
+        const __m128 fade = _mm_set1_ps(params.fadeRate * params.dt);
+        const __m128 negBounce = _mm_set1_ps(-params.bounce);
+        const __m128 friction = _mm_set1_ps(params.friction);
+
+        // SSE2 has no blendv: select(mask, a, b) = (mask & b) | (~mask & a)
+        auto select = [](__m128 mask, __m128 a, __m128 b) {
+            return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+        };
+
+        for (; i + 4 <= end; i += 4)
+        {
+            _mm_storeu_ps(&p.life[i], _mm_sub_ps(_mm_loadu_ps(&p.life[i]), dt));
+
+            const __m128 g = _mm_loadu_ps(&p.gravityScale[i]);
+            __m128 vx = _mm_add_ps(_mm_loadu_ps(&p.velX[i]), _mm_mul_ps(gx, g));
+            __m128 vy = _mm_add_ps(_mm_loadu_ps(&p.velY[i]), _mm_mul_ps(gy, g));
+            __m128 vz = _mm_add_ps(_mm_loadu_ps(&p.velZ[i]), _mm_mul_ps(gz, g));
+            const __m128 px = _mm_add_ps(_mm_loadu_ps(&p.posX[i]), _mm_mul_ps(vx, dt));
+            __m128 py = _mm_add_ps(_mm_loadu_ps(&p.posY[i]), _mm_mul_ps(vy, dt));
+            const __m128 pz = _mm_add_ps(_mm_loadu_ps(&p.posZ[i]), _mm_mul_ps(vz, dt));
+            _mm_storeu_ps(&p.colA[i], _mm_sub_ps(_mm_loadu_ps(&p.colA[i]), fade));
+
+            const __m128 floorY = _mm_loadu_ps(&p.floorY[i]);
+            const __m128 below = _mm_cmplt_ps(py, floorY);
+            py = select(below, py, floorY);
+            vy = select(below, vy, _mm_mul_ps(vy, negBounce));
+            vx = select(below, vx, _mm_mul_ps(vx, friction));
+            vz = select(below, vz, _mm_mul_ps(vz, friction));
+
+            _mm_storeu_ps(&p.posX[i], px);
+            _mm_storeu_ps(&p.posY[i], py);
+            _mm_storeu_ps(&p.posZ[i], pz);
+            _mm_storeu_ps(&p.velX[i], vx);
+            _mm_storeu_ps(&p.velY[i], vy);
+            _mm_storeu_ps(&p.velZ[i], vz);
+        }
+#endif
+
+        // Remaining particles (or everything, without SIMD)
+        IntegrateScalarRange(p, i, end, params);
+    }
+
+    void CollideWithBoxes(ParticleSoA& p, size_t begin, size_t end, const ColliderGrid& colliders,
+                          const ParticleIntegrateParams& params)
+    {
+        constexpr float kSkin = 1e-3f; // keeps resolved particles just outside the face
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            colliders.ForEachAtPoint(glm::vec2(p.posX[i], p.posZ[i]), [&](const AABB& box) {
+                const float x = p.posX[i], y = p.posY[i], z = p.posZ[i];
+                if (x < box.min.x || x > box.max.x || y < box.min.y || y > box.max.y ||
+                    z < box.min.z || z > box.max.z)
+                    return;
+
+                // Where the particle came from decides the face it went through
+                const float prevY = y - p.velY[i] * params.dt;
+                if (prevY >= box.max.y)
+                {
+                    p.posY[i] = box.max.y + kSkin;
+                    p.velY[i] = -p.velY[i] * params.bounce;
+                    p.velX[i] *= params.friction;
+                    p.velZ[i] *= params.friction;
+                }
+                else if (prevY <= box.min.y)
+                {
+                    p.posY[i] = box.min.y - kSkin;
+                    p.velY[i] = -p.velY[i] * params.bounce;
+                }
+                else
+                {
+                    // Side hit: leave through the closest X or Z face
+                    const float toMinX = x - box.min.x, toMaxX = box.max.x - x;
+                    const float toMinZ = z - box.min.z, toMaxZ = box.max.z - z;
+                    const float bestX = std::min(toMinX, toMaxX);
+                    const float bestZ = std::min(toMinZ, toMaxZ);
+                    if (bestX < bestZ)
+                    {
+                        p.posX[i] = (toMinX < toMaxX) ? box.min.x - kSkin : box.max.x + kSkin;
+                        p.velX[i] = -p.velX[i] * params.bounce;
+                    }
+                    else
+                    {
+                        p.posZ[i] = (toMinZ < toMaxZ) ? box.min.z - kSkin : box.max.z + kSkin;
+                        p.velZ[i] = -p.velZ[i] * params.bounce;
+                    }
+                }
+            });
+        }
+    }
+
+    size_t CompactDead(ParticleSoA& particles, size_t count)
+    {
+        size_t i = 0;
+        while (i < count)
+        {
+            if (particles.life[i] <= 0.0f)
+            {
+                particles.Copy(i, --count);
+                continue; // re-examine the particle moved into slot i
+            }
+            ++i;
+        }
+        return count;
+    }
+
+    uint16_t FloatToHalf(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+
+        const uint32_t sign = (bits >> 16) & 0x8000u;
+        const uint32_t absBits = bits & 0x7FFFFFFFu;
+
+        if (absBits >= 0x7F800000u) // Inf / NaN
+            return static_cast<uint16_t>(sign | 0x7C00u | (absBits > 0x7F800000u ? 0x200u : 0u));
+        if (absBits >= 0x477FF000u) // rounds to >= 65520: overflow
+            return static_cast<uint16_t>(sign | 0x7C00u);
+        if (absBits < 0x38800000u)  // below the smallest normal half: denormal or zero
+        {
+            if (absBits < 0x33000000u) return static_cast<uint16_t>(sign); // < half of the smallest denormal
+            const uint32_t exponent = absBits >> 23;
+            const uint32_t mantissa = (absBits & 0x7FFFFFu) | 0x800000u;
+            const uint32_t shift = 126u - exponent;
+            uint32_t half = mantissa >> shift;
+            const uint32_t remainder = mantissa & ((1u << shift) - 1u);
+            const uint32_t halfway = 1u << (shift - 1u);
+            if (remainder > halfway || (remainder == halfway && (half & 1u))) ++half;
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        // Normal: rebias the exponent, round the mantissa to nearest even
+        uint32_t half = ((absBits - 0x38000000u) >> 13);
+        const uint32_t remainder = absBits & 0x1FFFu;
+        if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) ++half;
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    void PackVertices(const ParticleSoA& p, size_t count, const glm::vec3& origin, ParticleVertex* out)
+    {
+        auto toUnorm8 = [](float v) {
+            return static_cast<uint8_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f);
+        };
+
+        size_t i = 0;
+#if defined(PARTICLE_KERNELS_AVX2) && defined(__F16C__)
+        // F16C converts 8 floats per instruction; x/y/z/size are converted column by column
+        const __m256 ox = _mm256_set1_ps(origin.x);
+        const __m256 oy = _mm256_set1_ps(origin.y);
+        const __m256 oz = _mm256_set1_ps(origin.z);
+        alignas(16) uint16_t hx[8], hy[8], hz[8], hs[8];
+        for (; i + 8 <= count; i += 8)
+        {
+            _mm_store_si128(reinterpret_cast<__m128i*>(hx), _mm256_cvtps_ph(_mm256_sub_ps(_mm256_loadu_ps(&p.posX[i]), ox), _MM_FROUND_TO_NEAREST_INT));
+            _mm_store_si128(reinterpret_cast<__m128i*>(hy), _mm256_cvtps_ph(_mm256_sub_ps(_mm256_loadu_ps(&p.posY[i]), oy), _MM_FROUND_TO_NEAREST_INT));
+            _mm_store_si128(reinterpret_cast<__m128i*>(hz), _mm256_cvtps_ph(_mm256_sub_ps(_mm256_loadu_ps(&p.posZ[i]), oz), _MM_FROUND_TO_NEAREST_INT));
+            _mm_store_si128(reinterpret_cast<__m128i*>(hs), _mm256_cvtps_ph(_mm256_loadu_ps(&p.size[i]), _MM_FROUND_TO_NEAREST_INT));
+            for (size_t k = 0; k < 8; ++k)
+            {
+                ParticleVertex& v = out[i + k];
+                v.x = hx[k]; v.y = hy[k]; v.z = hz[k]; v.size = hs[k];
+                v.r = toUnorm8(p.colR[i + k]); v.g = toUnorm8(p.colG[i + k]);
+                v.b = toUnorm8(p.colB[i + k]); v.a = toUnorm8(p.colA[i + k]);
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            ParticleVertex& v = out[i];
+            v.x = FloatToHalf(p.posX[i] - origin.x);
+            v.y = FloatToHalf(p.posY[i] - origin.y);
+            v.z = FloatToHalf(p.posZ[i] - origin.z);
+            v.size = FloatToHalf(p.size[i]);
+            v.r = toUnorm8(p.colR[i]); v.g = toUnorm8(p.colG[i]);
+            v.b = toUnorm8(p.colB[i]); v.a = toUnorm8(p.colA[i]);
+        }
+    }
+
+    const char* GetSimdName()
+    {
+#if defined(PARTICLE_KERNELS_AVX2)
+        return "AVX2";
+#elif defined(PARTICLE_KERNELS_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+}
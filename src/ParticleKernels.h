@@ -0,0 +1,85 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cfloat>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ColliderGrid;
+
+// Structure-of-arrays particle storage: one contiguous float array per component,
+// so the integrator can load 4 (SSE) or 8 (AVX2) particles per instruction.
+struct ParticleSoA
+{
+    std::vector<float> posX, posY, posZ;
+    std::vector<float> velX, velY, velZ;
+    std::vector<float> colR, colG, colB, colA;
+    std::vector<float> life;
+    std::vector<float> floorY;        // height the particle bounces at (-FLT_MAX: no floor)
+    std::vector<float> gravityScale;  // multiplies ParticleIntegrateParams::gravity (negative rises)
+    std::vector<float> size;          // point size in pixels
+
+    void Resize(size_t count);
+    size_t Capacity() const { return life.size(); }
+
+    void Set(size_t i, const glm::vec3& position, const glm::vec3& velocity, const glm::vec4& color, float lifetime,
+             float floor = -FLT_MAX, float gravityMultiplier = 1.0f, float pointSize = 10.0f);
+    void Copy(size_t dst, size_t src);
+
+    glm::vec3 GetPosition(size_t i) const { return glm::vec3(posX[i], posY[i], posZ[i]); }
+};
+
+// Packed draw vertex (12 bytes instead of 28 for float position + color):
+// half-float position relative to a draw origin, half-float point size, RGBA8 color.
+// Attributes: location 0 = 4 x GL_HALF_FLOAT (xyz, size), location 1 = 4 x normalized GL_UNSIGNED_BYTE.
+struct ParticleVertex
+{
+    uint16_t x, y, z, size;
+    uint8_t r, g, b, a;
+};
+static_assert(sizeof(ParticleVertex) == 12, "ParticleVertex must stay tightly packed");
+
+// Per-step integration constants
+struct ParticleIntegrateParams
+{
+    float dt = 0.0f;
+    glm::vec3 gravity = glm::vec3(0.0f, -9.8f, 0.0f);
+    float fadeRate = 0.5f;   // alpha lost per second
+    float bounce = 0.2f;     // fraction of vertical speed kept (reflected) on a bounce
+    float friction = 0.6f;   // fraction of horizontal speed kept on a bounce
+};
+
+namespace ParticleKernels
+{
+    // life -= dt; v += g*gravityScale*dt; p += v*dt; alpha fades; bounce at the particle's floorY.
+    // Operates on [0, count).
+    // Dispatches to the widest SIMD path this translation unit was compiled for.
+    void Integrate(ParticleSoA& particles, size_t count, const ParticleIntegrateParams& params);
+
+    // Same on [begin, end) only; disjoint ranges can run on different threads
+    void Integrate(ParticleSoA& particles, size_t begin, size_t end, const ParticleIntegrateParams& params);
+
+    // Reference scalar implementation (same results up to floating-point rounding)
+    void IntegrateScalar(ParticleSoA& particles, size_t count, const ParticleIntegrateParams& params);
+
+    // Pushes particles [begin, end) out of the grid's boxes after an Integrate step: landing on a
+    // top face bounces like the floor, hitting a side or bottom face reflects that velocity axis.
+    // Each particle looks at the boxes of its own grid cell only. Thread-safe for disjoint ranges.
+    void CollideWithBoxes(ParticleSoA& particles, size_t begin, size_t end, const ColliderGrid& colliders,
+                          const ParticleIntegrateParams& params);
+
+    // Swap-removes particles whose life ran out; returns the new live count.
+    size_t CompactDead(ParticleSoA& particles, size_t count);
+
+    // Writes particles [0, count) as ParticleVertex, positions relative to origin. Half floats keep
+    // ~3 significant digits, so origin should be near the particles that matter (e.g. the camera).
+    // Colors are clamped to [0, 1].
+    void PackVertices(const ParticleSoA& particles, size_t count, const glm::vec3& origin, ParticleVertex* out);
+
+    // IEEE float -> half (round to nearest even; overflow to infinity)
+    uint16_t FloatToHalf(float value);
+
+    // "AVX2", "SSE2" or "scalar"
+    const char* GetSimdName();
+}
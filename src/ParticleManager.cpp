@@ -0,0 +1,159 @@
+#include "ParticleManager.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+ParticleManager::ParticleManager(unsigned int capacity, uint64_t seed)
+    : capacity(capacity),
+      vertexStream(GL_ARRAY_BUFFER, capacity * sizeof(ParticleVertex)),
+      rng(seed)
+{
+    // Setup VAO over the whole stream buffer; Draw() picks the region with the first vertex
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, vertexStream.GetBuffer());
+    glEnableVertexAttribArray(0); // position (relative to drawOrigin) + point size
+    glVertexAttribPointer(0, 4, GL_HALF_FLOAT, GL_FALSE, sizeof(ParticleVertex), (void*)offsetof(ParticleVertex, x));
+    glEnableVertexAttribArray(1); // color
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ParticleVertex), (void*)offsetof(ParticleVertex, r));
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // Fill particles with default data (all dead)
+    particles.Resize(capacity);
+}
+
+ParticleManager::EmitterId ParticleManager::AddEmitter(const ParticleEmitterDesc& desc)
+{
+    emitters.push_back(Emitter{ desc, 0.0f });
+    return static_cast<EmitterId>(emitters.size() - 1);
+}
+
+Particle ParticleManager::Spawn(const ParticleEmitterDesc& emitter, const float* random)
+{
+    // Pick a spawn desc by weight
+    float totalWeight = 0.0f;
+    for (const ParticleSpawnDesc& spawn : emitter.spawns) totalWeight += spawn.weight;
+
+    float pick = random[0] * totalWeight;
+    const ParticleSpawnDesc* chosen = &emitter.spawns.back();
+    for (const ParticleSpawnDesc& spawn : emitter.spawns) {
+        if (pick < spawn.weight) {
+            chosen = &spawn;
+            break;
+        }
+        pick -= spawn.weight;
+    }
+    const ParticleSpawnDesc& desc = *chosen;
+
+    // Position on the shape, and the outward direction for radialSpeed
+    glm::vec3 local(0.0f);
+    glm::vec3 outward(0.0f);
+    if (desc.shape != ParticleSpawnDesc::Shape::Point) {
+        const float angle = random[1] * 6.2831853f;
+        outward = glm::vec3(std::cos(angle), 0.0f, std::sin(angle));
+        // Disc: sqrt keeps the density uniform over the area
+        const float r = (desc.shape == ParticleSpawnDesc::Shape::Ring) ? desc.radius : desc.radius * std::sqrt(random[2]);
+        local = outward * r;
+    }
+
+    const glm::vec3 t(random[3], random[4], random[5]);
+
+    Particle p;
+    p.Position = emitter.position + desc.offset + local;
+    p.Velocity = desc.velocityMin + (desc.velocityMax - desc.velocityMin) * t + outward * desc.radialSpeed;
+    p.Color = desc.color;
+    p.Size = desc.size;
+    p.Life = desc.life;
+    return p;
+}
+
+void ParticleManager::SpawnNew(float dt)
+{
+    // Add new particles: free slots start right after the live range.
+    // Every spawn reads a fixed slice of one random batch, so spawns are independent of each other.
+    for (Emitter& emitter : emitters)
+    {
+        const ParticleEmitterDesc& desc = emitter.desc;
+        if (!desc.enabled || desc.spawns.empty()) continue;
+
+        emitter.pending += desc.rate * dt;
+        const unsigned int wanted = static_cast<unsigned int>(emitter.pending);
+        emitter.pending -= static_cast<float>(wanted);
+
+        const unsigned int spawnCount = std::min(wanted, capacity - liveCount); // pool full: drop the rest
+        if (spawnCount == 0) continue;
+
+        spawnRandoms.resize(spawnCount * kRandomsPerSpawn);
+        rng.Fill(spawnRandoms.data(), spawnRandoms.size());
+        for (unsigned int i = 0; i < spawnCount; ++i)
+        {
+            const Particle p = Spawn(desc, &spawnRandoms[i * kRandomsPerSpawn]);
+            particles.Set(liveCount++, p.Position, p.Velocity, p.Color, p.Life, desc.floorY, desc.gravityScale, p.Size);
+        }
+    }
+}
+
+ParticleIntegrateParams ParticleManager::MakeIntegrateParams(float dt) const
+{
+    ParticleIntegrateParams params;
+    params.dt = dt;
+    params.gravity = Gravity;
+    params.fadeRate = 0.5f;   // Fade out
+    params.bounce = 0.2f;     // Small splash
+    params.friction = 0.6f;
+    return params;
+}
+
+void ParticleManager::Step(size_t begin, size_t end, const ParticleIntegrateParams& params)
+{
+    ParticleKernels::Integrate(particles, begin, end, params);
+    if (colliders != nullptr && !colliders->Empty())
+        ParticleKernels::CollideWithBoxes(particles, begin, end, *colliders, params);
+}
+
+void ParticleManager::Update(float dt)
+{
+    SpawnNew(dt);
+
+    // Integrate every live particle, then swap-remove the ones whose life ran out
+    Step(0, liveCount, MakeIntegrateParams(dt));
+    liveCount = static_cast<unsigned int>(ParticleKernels::CompactDead(particles, liveCount));
+}
+
+void ParticleManager::BeginUpdate(float dt, JobSystem& jobs)
+{
+    SpawnNew(dt);
+
+    // Chunks are multiples of 8 so every chunk but the last runs entirely in the SIMD loop
+    const ParticleIntegrateParams params = MakeIntegrateParams(dt);
+    activeJobs = &jobs;
+    jobs.Dispatch(updateGroup, liveCount, kUpdateChunkSize, [this, params](size_t begin, size_t end) {
+        Step(begin, end, params);
+    });
+}
+
+void ParticleManager::EndUpdate()
+{
+    if (activeJobs == nullptr) return;
+    activeJobs->Wait(updateGroup);
+    activeJobs = nullptr;
+
+    liveCount = static_cast<unsigned int>(ParticleKernels::CompactDead(particles, liveCount));
+}
+
+void ParticleManager::Draw()
+{
+    if (liveCount == 0) return;
+
+    // Live particles are contiguous: pack them straight into this frame's region
+    ParticleVertex* vertices = static_cast<ParticleVertex*>(vertexStream.Map());
+    ParticleKernels::PackVertices(particles, liveCount, drawOrigin, vertices);
+    vertexStream.Commit(liveCount * sizeof(ParticleVertex));
+
+    glBindVertexArray(VAO);
+    glDrawArrays(GL_POINTS, vertexStream.GetRegionIndex() * capacity, liveCount);
+    glBindVertexArray(0);
+
+    vertexStream.Fence();
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include <cfloat>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "Shader.h"
+#include "ParticleKernels.h"
+#include "StreamBuffer.h"
+#include "Random.h"
+#include "JobSystem.h"
+#include "ColliderGrid.h"
+
+struct Particle {
+    glm::vec3 Position;
+    glm::vec3 Velocity;
+    glm::vec4 Color;
+    float Size;
+    float Life;
+};
+
+// One way an emitter spawns particles (an emitter picks one of its spawn descs per particle,
+// weighted by `weight`). Positions are relative to the emitter.
+struct ParticleSpawnDesc {
+    enum class Shape { Point, Ring, Disc };
+
+    float weight = 1.0f;
+    Shape shape = Shape::Point;
+    glm::vec3 offset = glm::vec3(0.0f);
+    float radius = 0.0f;                          // Ring / Disc
+    glm::vec3 velocityMin = glm::vec3(0.0f);      // uniform random per component
+    glm::vec3 velocityMax = glm::vec3(0.0f);
+    float radialSpeed = 0.0f;                     // extra speed away from the shape's center (Ring / Disc)
+    glm::vec4 color = glm::vec4(1.0f);
+    float size = 10.0f;                           // point size in pixels
+    float life = 1.0f;                            // seconds
+};
+
+// Data-driven emitter: where, how often and how particles spawn and behave
+struct ParticleEmitterDesc {
+    glm::vec3 position = glm::vec3(0.0f);
+    float rate = 100.0f;            // particles per second
+    float gravityScale = 1.0f;      // negative values rise (smoke)
+    float floorY = -FLT_MAX;        // particles bounce at this height
+    bool enabled = true;
+    std::vector<ParticleSpawnDesc> spawns;
+};
+
+// Hosts any number of emitters on one shared particle pool, simulated in one pass and
+// drawn with one draw call. Live particles are kept contiguous in particles[0, liveCount):
+// - storage is structure-of-arrays (ParticleSoA) so ParticleKernels::Integrate can
+//   update 4/8 particles per SIMD instruction; per-emitter behavior (floor, gravity scale)
+//   is stored per particle, so particles of all emitters integrate together
+// - particles bounce off the static world boxes via the ColliderGrid (one cell lookup each)
+// - vertices (half-float position + size, RGBA8 color: ParticleVertex, 12 bytes) are packed
+//   straight into a persistently mapped, triple-buffered vertex ring (StreamBuffer)
+// - spawning takes the slot right after the last live particle (O(1), no search)
+// - a particle that dies is swap-removed with the last live one, so updates and
+//   uploads only touch live particles
+// - emission draws from its own seeded RNG (no rand()), so a seed reproduces a run exactly
+class ParticleManager {
+public:
+    using EmitterId = uint32_t;
+
+    ParticleManager(unsigned int capacity, uint64_t seed = 1);
+
+    EmitterId AddEmitter(const ParticleEmitterDesc& desc);
+    ParticleEmitterDesc& GetEmitter(EmitterId id) { return emitters[id].desc; }
+    size_t GetEmitterCount() const { return emitters.size(); }
+
+    // Removes every emitter; particles already alive finish their life
+    void ClearEmitters() { emitters.clear(); }
+
+    // Spawns each enabled emitter's share of particles for dt, then steps every live particle
+    void Update(float dt);
+
+    // Same as Update, split in two so integration overlaps other work: BeginUpdate spawns and
+    // queues the integration in chunks on the job system, EndUpdate waits and removes dead
+    // particles. Nothing else may touch the manager in between.
+    void BeginUpdate(float dt, JobSystem& jobs);
+    void EndUpdate();
+
+    // Draws every live particle; the bound program must add particleOrigin (GetDrawOrigin)
+    // to the half-float positions
+    void Draw();
+
+    // Packed positions are relative to this point; keep it near the camera for best precision
+    void SetDrawOrigin(const glm::vec3& origin) { drawOrigin = origin; }
+    const glm::vec3& GetDrawOrigin() const { return drawOrigin; }
+
+    // Static world boxes particles bounce off (nullptr: only each emitter's floorY). Not owned.
+    void SetColliders(const ColliderGrid* grid) { colliders = grid; }
+
+    unsigned int GetLiveCount() const { return liveCount; }
+    unsigned int GetCapacity() const { return capacity; }
+
+    // Restarts the emission random sequence
+    void Seed(uint64_t seed) { rng.Seed(seed); }
+
+    // Config
+    glm::vec3 Gravity = glm::vec3(0.0f, -9.8f, 0.0f);
+
+private:
+    static constexpr size_t kRandomsPerSpawn = 6;
+    static constexpr size_t kUpdateChunkSize = 16384; // particles per job
+
+    struct Emitter {
+        ParticleEmitterDesc desc;
+        float pending = 0.0f; // fractional particles carried over to the next frame
+    };
+
+    void SpawnNew(float dt);
+    ParticleIntegrateParams MakeIntegrateParams(float dt) const;
+
+    // Integration + world collision of particles [begin, end)
+    void Step(size_t begin, size_t end, const ParticleIntegrateParams& params);
+
+    // Initializes a freshly spawned particle from kRandomsPerSpawn uniform [0, 1) values
+    static Particle Spawn(const ParticleEmitterDesc& emitter, const float* random);
+
+    ParticleSoA particles;
+    unsigned int capacity;
+    unsigned int liveCount = 0;
+    unsigned int VAO = 0;
+
+    std::vector<Emitter> emitters;
+    const ColliderGrid* colliders = nullptr;
+
+    StreamBuffer vertexStream; // capacity vertices per region
+    glm::vec3 drawOrigin = glm::vec3(0.0f);
+
+    Xoshiro128Plus4 rng;
+    std::vector<float> spawnRandoms; // one batch per emitter per Update, reused
+
+    JobSystem* activeJobs = nullptr; // set between BeginUpdate and EndUpdate
+    JobSystem::JobGroup updateGroup;
+};
@@ -35,7 +35,7 @@ AABB Player::GetPlayerBox(const glm::vec3& pos) const {
     return box;
 }
 
-bool Player::CheckCollision(const glm::vec3& newPos, const std::vector<AABB>& colliders) {
+bool Player::CheckCollision(const glm::vec3& newPos, const CollisionWorld& world) {
     AABB playerBox = GetPlayerBox(newPos);
     // Raise the bottom check slightly (step tolerance) so we don't get stuck on floor seams
     // But we MUST NOT raise it too much or we walk through walls that are floating slightly? No, walls are usually floor-to-ceiling.
@@ -43,20 +43,15 @@ bool Player::CheckCollision(const glm::vec3& newPos, const std::vector<AABB>& co
     // So if a wall is only 0.2m high, we walk over it.
     playerBox.min.y += 0.25f; 
 
-    for (const auto& box : colliders) {
-        if (playerBox.Overlaps(box)) {
-            return true;
-        }
-    }
-    return false;
+    return world.Overlaps(playerBox);
 }
 
-float Player::GetFloorHeight(const glm::vec3& pos, const std::vector<AABB>& colliders) {
+float Player::GetFloorHeight(const glm::vec3& pos, const CollisionWorld& world) {
     AABB playerBox = GetPlayerBox(pos);
     float bestY = -FLT_MAX;
     
     // We check for boxes that intersect our XZ footprint and are below our head
-    for (const auto& box : colliders) {
+    auto considerFloor = [&](const AABB& box) {
         // Check XZ overlap
         if (playerBox.min.x <= box.max.x && playerBox.max.x >= box.min.x &&
             playerBox.min.z <= box.max.z && playerBox.max.z >= box.min.z) {
@@ -68,7 +63,10 @@ float Player::GetFloorHeight(const glm::vec3& pos, const std::vector<AABB>& coll
                  bestY = std::max(bestY, box.max.y);
             }
         }
-    }
+    };
+
+    world.ForEachCandidate(glm::vec2(playerBox.min.x, playerBox.min.z),
+                           glm::vec2(playerBox.max.x, playerBox.max.z), considerFloor);
     
     // Safety Net: Infinite Floor at Y = 0.0
     if (bestY == -FLT_MAX) {
@@ -78,7 +76,7 @@ float Player::GetFloorHeight(const glm::vec3& pos, const std::vector<AABB>& coll
     return std::max(bestY, 0.0f);
 }
 
-void Player::ProcessInputs(GLFWwindow* window, float deltaTime, const std::vector<AABB>& colliders) {
+void Player::ProcessInputs(GLFWwindow* window, float deltaTime, const CollisionWorld& world) {
     // 0. Toggle Fly Mode (V Key)
     if (glfwGetKey(window, GLFW_KEY_V) == GLFW_PRESS) {
         if (!flyTogglePressed) {
@@ -158,7 +156,7 @@ void Player::ProcessInputs(GLFWwindow* window, float deltaTime, const std::vecto
     glm::vec3 nextPos = currentPos + targetVelXZ * deltaTime;
     
     // Attempt FULL Move
-    if (!CheckCollision(nextPos, colliders)) {
+    if (!CheckCollision(nextPos, world)) {
         currentPos.x = nextPos.x;
         currentPos.z = nextPos.z;
     } 
@@ -168,7 +166,7 @@ void Player::ProcessInputs(GLFWwindow* window, float deltaTime, const std::vecto
         glm::vec3 stepPos = nextPos;
         stepPos.y += stepHeight; 
         
-        if (!CheckCollision(stepPos, colliders)) {
+        if (!CheckCollision(stepPos, world)) {
             // Success! We can move if we step up.
             currentPos.x = nextPos.x;
             currentPos.z = nextPos.z;
@@ -177,13 +175,13 @@ void Player::ProcessInputs(GLFWwindow* window, float deltaTime, const std::vecto
         else {
             // Cannot step up. Try Sliding (X only)
             glm::vec3 nextPosX = currentPos + glm::vec3(targetVelXZ.x * deltaTime, 0.0f, 0.0f);
-            if (!CheckCollision(nextPosX, colliders)) {
+            if (!CheckCollision(nextPosX, world)) {
                 currentPos.x = nextPosX.x;
             } else {
                 // Try stepping X
                 glm::vec3 stepPosX = nextPosX; 
                 stepPosX.y += stepHeight;
-                if (!CheckCollision(stepPosX, colliders)) {
+                if (!CheckCollision(stepPosX, world)) {
                      currentPos.x = nextPosX.x;
                      currentPos.y += stepHeight;
                 }
@@ -191,13 +189,13 @@ void Player::ProcessInputs(GLFWwindow* window, float deltaTime, const std::vecto
             
             // Try Sliding (Z only)
             glm::vec3 nextPosZ = currentPos + glm::vec3(0.0f, 0.0f, targetVelXZ.z * deltaTime);
-            if (!CheckCollision(nextPosZ, colliders)) {
+            if (!CheckCollision(nextPosZ, world)) {
                 currentPos.z = nextPosZ.z;
             } else {
                 // Try stepping Z
                 glm::vec3 stepPosZ = nextPosZ; 
                 stepPosZ.y += stepHeight;
-                if (!CheckCollision(stepPosZ, colliders)) {
+                if (!CheckCollision(stepPosZ, world)) {
                      currentPos.z = nextPosZ.z;
                      currentPos.y += stepHeight;
                 }
@@ -213,7 +211,7 @@ void Player::ProcessInputs(GLFWwindow* window, float deltaTime, const std::vecto
     float nextY = currentPos.y + velocity.y * deltaTime;
     
     // Find floor height at current XZ
-    float floorHeight = GetFloorHeight(glm::vec3(currentPos.x, nextY, currentPos.z), colliders);
+    float floorHeight = GetFloorHeight(glm::vec3(currentPos.x, nextY, currentPos.z), world);
     float desiredFeetY = floorHeight;
     float desiredHeadY = floorHeight + Height;
     
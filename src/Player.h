@@ -2,6 +2,7 @@
 
 #include "Camera.h"
 #include "Collision.h"
+#include "CollisionWorld.h"
 #include <GLFW/glfw3.h>
 #include <vector>
 
@@ -9,7 +10,7 @@ class Player {
 public:
     Player(glm::vec3 position);
 
-    void ProcessInputs(GLFWwindow* window, float deltaTime, const std::vector<AABB>& colliders);
+    void ProcessInputs(GLFWwindow* window, float deltaTime, const CollisionWorld& world);
     void ProcessMouseMovement(float xoffset, float yoffset);
 
     glm::mat4 GetViewMatrix() const;
@@ -38,8 +39,8 @@ private:
     
     // Check if the player AABB (at newPos) collides with any world box
     // Returns true if collision detected
-    bool CheckCollision(const glm::vec3& newPos, const std::vector<AABB>& colliders);
+    bool CheckCollision(const glm::vec3& newPos, const CollisionWorld& world);
     
     // Returns the Y coordinate of the floor at a specific position, or -FLT_MAX if free space
-    float GetFloorHeight(const glm::vec3& pos, const std::vector<AABB>& colliders);
+    float GetFloorHeight(const glm::vec3& pos, const CollisionWorld& world);
 };
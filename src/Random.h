@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define RANDOM_SSE2 1
+#endif
+
+// Small, fast, deterministic random number generators (xoshiro128+, Blackman & Vigna).
+// Unlike rand() they carry their own state, so every emitter / thread can own one and
+// a given seed always reproduces the same sequence on every platform.
+
+namespace RandomDetail
+{
+    // splitmix64: expands a 64-bit seed into well mixed state words
+    inline uint64_t SplitMix64(uint64_t& x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    inline uint32_t Rotl(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+
+    // Upper 24 bits -> float in [0, 1)
+    inline float ToFloat01(uint32_t x) { return static_cast<float>(x >> 8) * (1.0f / 16777216.0f); }
+}
+
+// Scalar xoshiro128+: 128-bit state, period 2^128 - 1. The low bits are weak, which is why
+// floats are built from the upper 24 bits only.
+class Xoshiro128Plus
+{
+public:
+    explicit Xoshiro128Plus(uint64_t seed = 1) { Seed(seed); }
+
+    void Seed(uint64_t seed)
+    {
+        const uint64_t a = RandomDetail::SplitMix64(seed);
+        const uint64_t b = RandomDetail::SplitMix64(seed);
+        s[0] = static_cast<uint32_t>(a); s[1] = static_cast<uint32_t>(a >> 32);
+        s[2] = static_cast<uint32_t>(b); s[3] = static_cast<uint32_t>(b >> 32);
+    }
+
+    uint32_t NextU32()
+    {
+        const uint32_t result = s[0] + s[3];
+        const uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = RandomDetail::Rotl(s[3], 11);
+        return result;
+    }
+
+    // [0, 1)
+    float NextFloat() { return RandomDetail::ToFloat01(NextU32()); }
+
+    // [lo, hi)
+    float Range(float lo, float hi) { return lo + (hi - lo) * NextFloat(); }
+
+private:
+    uint32_t s[4];
+};
+
+// Four independent xoshiro128+ streams stepped together (SSE2 when available), for filling
+// large batches of random floats. Lane i is seeded from seed + i, so the output is fixed by the
+// seed alone; Fill() interleaves the lanes (out[4k + i] comes from lane i).
+class Xoshiro128Plus4
+{
+public:
+    explicit Xoshiro128Plus4(uint64_t seed = 1) { Seed(seed); }
+
+    void Seed(uint64_t seed)
+    {
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            uint64_t x = seed + static_cast<uint64_t>(lane);
+            const uint64_t a = RandomDetail::SplitMix64(x);
+            const uint64_t b = RandomDetail::SplitMix64(x);
+            s0[lane] = static_cast<uint32_t>(a); s1[lane] = static_cast<uint32_t>(a >> 32);
+            s2[lane] = static_cast<uint32_t>(b); s3[lane] = static_cast<uint32_t>(b >> 32);
+        }
+    }
+
+    // Writes count floats in [0, 1)
+    void Fill(float* out, size_t count)
+    {
+        size_t i = 0;
+#if defined(RANDOM_SSE2)
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s0));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s1));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s2));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s3));
+        const __m128 scale = _mm_set1_ps(1.0f / 16777216.0f);
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i result = _mm_add_epi32(a, d);
+            const __m128i t = _mm_slli_epi32(b, 9);
+            c = _mm_xor_si128(c, a);
+            d = _mm_xor_si128(d, b);
+            b = _mm_xor_si128(b, c);
+            a = _mm_xor_si128(a, d);
+            c = _mm_xor_si128(c, t);
+            d = _mm_or_si128(_mm_slli_epi32(d, 11), _mm_srli_epi32(d, 21));
+
+            // Upper 24 bits fit in a signed int, so the signed conversion is exact
+            const __m128 f = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(result, 8)), scale);
+            _mm_storeu_ps(out + i, f);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s0), a);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s1), b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s2), c);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s3), d);
+#endif
+        // Scalar steps (the tail, or everything without SSE2); same lane order as the SIMD loop
+        for (; i < count; ++i)
+            out[i] = RandomDetail::ToFloat01(Step(static_cast<int>(i & 3)));
+    }
+
+private:
+    uint32_t Step(int lane)
+    {
+        const uint32_t result = s0[lane] + s3[lane];
+        const uint32_t t = s1[lane] << 9;
+        s2[lane] ^= s0[lane];
+        s3[lane] ^= s1[lane];
+        s1[lane] ^= s2[lane];
+        s0[lane] ^= s3[lane];
+        s2[lane] ^= t;
+        s3[lane] = RandomDetail::Rotl(s3[lane], 11);
+        return result;
+    }
+
+    uint32_t s0[4], s1[4], s2[4], s3[4]; // one column per lane
+};
@@ -0,0 +1,122 @@
+#include "SceneArena.h"
+#include "SceneNode.h"
+
+uint16_t SceneArena::s_poolCount = 0;
+
+SceneArena& SceneArena::Get()
+{
+    // Never destroyed: static handles (SchoolBuilder's node lists) may still be released during exit
+    static SceneArena* arena = new SceneArena();
+    return *arena;
+}
+
+SceneArena::SceneArena()
+    : slots(1)
+{
+}
+
+void* SceneArena::Allocate(uint16_t pool, size_t size)
+{
+    if (pool >= pools.size()) pools.resize(pool + 1);
+    Pool& p = pools[pool];
+    if (p.slotSize == 0)
+    {
+        // Every slot starts max_align_t-aligned, like a heap allocation
+        const size_t align = alignof(std::max_align_t);
+        p.slotSize = (size + align - 1) / align * align;
+    }
+
+    if (p.freeList.empty())
+    {
+        p.chunks.push_back(std::make_unique<std::byte[]>(p.slotSize * kNodesPerChunk));
+        std::byte* chunk = p.chunks.back().get();
+        // Pop order follows memory order, so nodes created in sequence are contiguous
+        for (size_t i = kNodesPerChunk; i-- > 0;)
+            p.freeList.push_back(chunk + i * p.slotSize);
+    }
+
+    void* memory = p.freeList.back();
+    p.freeList.pop_back();
+    ++p.liveCount;
+    return memory;
+}
+
+void SceneArena::Free(uint16_t pool, void* memory)
+{
+    pools[pool].freeList.push_back(memory);
+    --pools[pool].liveCount;
+}
+
+NodeHandle SceneArena::AllocateSlot(SceneNode* node, uint16_t pool)
+{
+    uint32_t index;
+    if (!freeSlots.empty())
+    {
+        index = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(slots.size());
+        if (index > kIndexMask) throw std::bad_alloc();
+        slots.emplace_back();
+    }
+
+    Slot& slot = slots[index];
+    slot.node = node;
+    slot.refs = 0;
+    slot.pool = pool;
+    return (static_cast<uint32_t>(slot.generation & 0xFF) << kIndexBits) | index;
+}
+
+SceneNode* SceneArena::TryResolve(NodeHandle handle) const
+{
+    const uint32_t index = handle & kIndexMask;
+    if (handle == kNullHandle || index >= slots.size()) return nullptr;
+    const Slot& slot = slots[index];
+    if ((slot.generation & 0xFF) != (handle >> kIndexBits)) return nullptr;
+    return slot.node;
+}
+
+void SceneArena::Destroy(uint32_t index)
+{
+    SceneNode* node = slots[index].node;
+    const uint16_t pool = slots[index].pool;
+    slots[index].node = nullptr;
+    ++slots[index].generation;
+
+    // The destructor releases the children, which may destroy further nodes,
+    // so this slot is only recycled afterwards.
+    // The base pointer is the start of the pool slot (checked in Create), so no RTTI is needed
+    // to find the most-derived object
+    void* memory = static_cast<void*>(node);
+    node->~SceneNode();
+    Free(pool, memory);
+    freeSlots.push_back(index);
+}
+
+SceneArena::MemoryStats SceneArena::GetMemoryStats() const
+{
+    MemoryStats stats;
+    for (const Pool& p : pools)
+    {
+        stats.liveNodes += p.liveCount;
+        stats.nodeBytes += p.liveCount * p.slotSize;
+        stats.reservedBytes += p.chunks.size() * kNodesPerChunk * p.slotSize;
+    }
+    stats.reservedBytes += slots.capacity() * sizeof(Slot) + freeSlots.capacity() * sizeof(uint32_t);
+    if (stats.liveNodes == 0) return stats;
+
+    stats.bytesPerNode = stats.reservedBytes / stats.liveNodes + sizeof(SceneNode::Ptr);
+
+    // The former layout: each node was its own make_shared block (control block with vtable and
+    // two counters, plus the allocator's header), carried an enable_shared_from_this weak_ptr and
+    // a weak_ptr parent instead of a raw pointer, and was linked from its parent by a shared_ptr
+    const size_t perNodeOverhead = 2 * sizeof(void*)                                // control block
+                                 + 2 * sizeof(void*)                                // malloc header / rounding
+                                 + sizeof(std::weak_ptr<SceneNode>)                 // enable_shared_from_this
+                                 + sizeof(std::weak_ptr<SceneNode>) - sizeof(SceneNode*) // parent
+                                 + sizeof(std::shared_ptr<SceneNode>);              // link in parent
+    stats.sharedPtrBytesPerNode = stats.nodeBytes / stats.liveNodes + perNodeOverhead;
+    return stats;
+}
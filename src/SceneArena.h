@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class SceneNode;
+
+// 32-bit node handle: slot index in the low 24 bits, slot generation in the high 8 bits.
+// 0 is the null handle.
+using NodeHandle = uint32_t;
+
+// Pooled storage for scene nodes.
+// Nodes are constructed in place inside fixed-size chunks, one pool per node type, so siblings
+// created together sit next to each other in memory and node addresses never move.
+// Each node is reached through a slot table entry holding its address and an intrusive
+// reference count; NodeRef (SceneNode::Ptr) is a 4-byte counted handle into that table, which
+// replaces shared_ptr's separate control block, weak_ptr parent and enable_shared_from_this.
+// A node is destroyed and its memory reused as soon as the last NodeRef to it goes away;
+// the slot's generation is then bumped so stale raw handles can be detected (TryResolve).
+// Not thread-safe: nodes are created and released on the render thread only.
+class SceneArena
+{
+public:
+    static constexpr NodeHandle kNullHandle = 0;
+    static constexpr uint32_t kIndexBits = 24;
+    static constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1;
+    static constexpr size_t kNodesPerChunk = 256;
+
+    struct MemoryStats
+    {
+        size_t liveNodes = 0;
+        size_t nodeBytes = 0;      // sizeof of the live nodes
+        size_t reservedBytes = 0;  // chunks + slot table
+        size_t bytesPerNode = 0;   // reserved bytes and the node's link in its parent, per live node
+        size_t sharedPtrBytesPerNode = 0; // same nodes as separate make_shared allocations (estimate)
+    };
+
+    // The process-wide arena used by MakeNode
+    static SceneArena& Get();
+
+    SceneArena(const SceneArena&) = delete;
+    SceneArena& operator=(const SceneArena&) = delete;
+
+    // Constructs a T in its pool and returns its handle with a reference count of 0
+    // (wrap it in a NodeRef to keep it alive).
+    template <typename T, typename... Args>
+    NodeHandle Create(Args&&... args);
+
+    // Handle -> node, for handles kept alive by a NodeRef
+    SceneNode* Resolve(NodeHandle handle) const { return slots[handle & kIndexMask].node; }
+
+    // Handle -> node, or nullptr if the node has been destroyed since the handle was taken
+    SceneNode* TryResolve(NodeHandle handle) const;
+
+    void AddRef(NodeHandle handle)
+    {
+        if (handle != kNullHandle) ++slots[handle & kIndexMask].refs;
+    }
+
+    void Release(NodeHandle handle)
+    {
+        if (handle != kNullHandle && --slots[handle & kIndexMask].refs == 0) Destroy(handle & kIndexMask);
+    }
+
+    MemoryStats GetMemoryStats() const;
+
+private:
+    SceneArena();
+
+    struct Slot
+    {
+        SceneNode* node = nullptr;
+        uint32_t refs = 0;
+        uint16_t generation = 0;
+        uint16_t pool = 0;
+    };
+
+    struct Pool
+    {
+        size_t slotSize = 0;
+        std::vector<std::unique_ptr<std::byte[]>> chunks;
+        std::vector<void*> freeList;
+        size_t liveCount = 0;
+    };
+
+    // Per-type pool id, assigned on first use
+    template <typename T>
+    static uint16_t PoolId()
+    {
+        static const uint16_t id = s_poolCount++;
+        return id;
+    }
+
+    void* Allocate(uint16_t pool, size_t size);
+    void Free(uint16_t pool, void* memory);
+    NodeHandle AllocateSlot(SceneNode* node, uint16_t pool);
+    void Destroy(uint32_t index);
+
+    static uint16_t s_poolCount;
+
+    std::vector<Slot> slots;            // slot 0 stays empty (null handle)
+    std::vector<uint32_t> freeSlots;
+    std::vector<Pool> pools;
+};
+
+template <typename T, typename... Args>
+NodeHandle SceneArena::Create(Args&&... args)
+{
+    static_assert(std::is_base_of_v<SceneNode, T>, "SceneArena only stores scene nodes");
+    static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned nodes are not supported");
+
+    const uint16_t pool = PoolId<T>();
+    void* memory = Allocate(pool, sizeof(T));
+    T* node = nullptr;
+    try
+    {
+        node = new (memory) T(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+        Free(pool, memory);
+        throw;
+    }
+    // Destroy frees the slot through the SceneNode pointer, so the base must start the slot
+    // (single, non-virtual inheritance from SceneNode)
+    assert(static_cast<void*>(static_cast<SceneNode*>(node)) == memory);
+    return AllocateSlot(node, pool);
+}
+
+// Counted handle to an arena node; the drop-in replacement for shared_ptr<T> in the scene graph
+// (get, ->, *, bool, comparisons, reset, implicit derived -> base conversion; NodeCast replaces
+// dynamic_pointer_cast).
+template <typename T>
+class NodeRef
+{
+public:
+    NodeRef() = default;
+    NodeRef(std::nullptr_t) {}
+
+    // Adopts one reference to handle
+    explicit NodeRef(NodeHandle handle) : handle(handle) { SceneArena::Get().AddRef(handle); }
+
+    NodeRef(const NodeRef& other) : handle(other.handle) { SceneArena::Get().AddRef(handle); }
+    NodeRef(NodeRef&& other) noexcept : handle(other.handle) { other.handle = SceneArena::kNullHandle; }
+
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    NodeRef(const NodeRef<U>& other) : handle(other.GetHandle()) { SceneArena::Get().AddRef(handle); }
+
+    ~NodeRef() { SceneArena::Get().Release(handle); }
+
+    NodeRef& operator=(NodeRef other) noexcept
+    {
+        std::swap(handle, other.handle);
+        return *this;
+    }
+
+    void reset() { NodeRef().swap(*this); }
+    void swap(NodeRef& other) noexcept { std::swap(handle, other.handle); }
+
+    T* get() const
+    {
+        return handle != SceneArena::kNullHandle ? static_cast<T*>(SceneArena::Get().Resolve(handle)) : nullptr;
+    }
+    T* operator->() const { return get(); }
+    T& operator*() const { return *get(); }
+    explicit operator bool() const { return handle != SceneArena::kNullHandle; }
+
+    NodeHandle GetHandle() const { return handle; }
+
+private:
+    NodeHandle handle = SceneArena::kNullHandle;
+};
+
+template <typename T, typename U>
+bool operator==(const NodeRef<T>& a, const NodeRef<U>& b) { return a.GetHandle() == b.GetHandle(); }
+template <typename T, typename U>
+bool operator!=(const NodeRef<T>& a, const NodeRef<U>& b) { return a.GetHandle() != b.GetHandle(); }
+template <typename T>
+bool operator==(const NodeRef<T>& a, std::nullptr_t) { return !a; }
+template <typename T>
+bool operator!=(const NodeRef<T>& a, std::nullptr_t) { return static_cast<bool>(a); }
@@ -0,0 +1,133 @@
+#include "SceneBVH.h"
+
+#include <algorithm>
+#include <cmath>
+
+void SceneBVH::Layer::Rebuild()
+{
+    boxes.resize(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i)
+        boxes[i] = WorldBounds(*meshes[i]);
+    bvh.Build(boxes);
+}
+
+void SceneBVH::Build(const SceneNode::Ptr& root, const std::vector<SceneNode::Ptr>& dynamicRoots)
+{
+    staticLayer.meshes.clear();
+    dynamicLayer.meshes.clear();
+
+    std::unordered_set<const SceneNode*> dynamicSet;
+    for (const auto& node : dynamicRoots)
+        dynamicSet.insert(node.get());
+
+    Collect(root, false, dynamicSet, staticLayer, dynamicLayer);
+
+    staticLayer.Rebuild();
+    dynamicLayer.Rebuild();
+}
+
+void SceneBVH::UpdateDynamic()
+{
+    dynamicLayer.Rebuild();
+}
+
+void SceneBVH::Collect(const SceneNode::Ptr& node, bool dynamic,
+                       const std::unordered_set<const SceneNode*>& dynamicRoots, Layer& staticOut, Layer& dynamicOut)
+{
+    if (!node) return;
+
+    if (!dynamic && dynamicRoots.count(node.get()) > 0)
+        dynamic = true;
+
+    if (MeshNode* meshNode = NodeCast<MeshNode>(node.get()))
+        (dynamic ? dynamicOut : staticOut).meshes.push_back(meshNode);
+
+    for (auto& c : node->children)
+        Collect(c, dynamic, dynamicRoots, staticOut, dynamicOut);
+}
+
+AABB SceneBVH::WorldBounds(const MeshNode& mesh)
+{
+    AABB local;
+    mesh.GetLocalBounds(local);
+    return TransformAABB(local, mesh.GetGlobalAffine());
+}
+
+bool SceneBVH::IntersectMesh(const MeshNode& mesh, const glm::vec3& origin, const glm::vec3& dir,
+                             float tMax, float& t, glm::vec3& normal)
+{
+    const glm::mat4 world = mesh.GetGlobalTransform();
+    const glm::mat4 inv = glm::inverse(world);
+
+    // The transform is affine, so t is the same parameter in local and world space
+    const glm::vec3 o = glm::vec3(inv * glm::vec4(origin, 1.0f));
+    const glm::vec3 d = glm::vec3(inv * glm::vec4(dir, 0.0f));
+    if (!std::isfinite(o.x) || !std::isfinite(d.x)) return false; // degenerate (zero-scale) transform
+
+    AABB local;
+    mesh.GetLocalBounds(local);
+    const glm::vec3 lo = local.min;
+    const glm::vec3 hi = local.max;
+
+    float tNear = 0.0f;
+    float tFar = tMax;
+    int hitAxis = -1;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (std::abs(d[axis]) < 1e-12f)
+        {
+            if (o[axis] < lo[axis] || o[axis] > hi[axis]) return false;
+            continue;
+        }
+
+        float t0 = (lo[axis] - o[axis]) / d[axis];
+        float t1 = (hi[axis] - o[axis]) / d[axis];
+        if (t0 > t1) std::swap(t0, t1);
+        if (t0 > tNear)
+        {
+            tNear = t0;
+            hitAxis = axis;
+        }
+        tFar = std::min(tFar, t1);
+        if (tNear > tFar) return false;
+    }
+
+    // Starting inside the box is not a hit (e.g. the camera inside a trigger volume)
+    if (hitAxis < 0) return false;
+
+    t = tNear;
+    glm::vec3 localNormal(0.0f);
+    localNormal[hitAxis] = d[hitAxis] > 0.0f ? -1.0f : 1.0f;
+    normal = glm::normalize(glm::mat3(glm::transpose(inv)) * localNormal);
+    return true;
+}
+
+void SceneBVH::RaycastLayer(const Layer& layer, const glm::vec3& origin, const glm::vec3& dir,
+                            float& tMax, RayHit& hit)
+{
+    layer.bvh.Raycast(origin, dir, tMax, [&](uint32_t item, float& maxT) {
+        MeshNode* mesh = layer.meshes[item];
+        float t = 0.0f;
+        glm::vec3 n;
+        if (IntersectMesh(*mesh, origin, dir, maxT, t, n) && t < maxT)
+        {
+            maxT = t;
+            hit.node = mesh;
+            hit.distance = t;
+            hit.normal = n;
+        }
+    });
+}
+
+bool SceneBVH::Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, RayHit& hit) const
+{
+    hit = RayHit{};
+    float tMax = maxDistance;
+
+    RaycastLayer(staticLayer, origin, dir, tMax, hit);
+    RaycastLayer(dynamicLayer, origin, dir, tMax, hit);
+
+    if (!hit.node) return false;
+    hit.point = origin + dir * hit.distance;
+    return true;
+}
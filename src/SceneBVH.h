@@ -0,0 +1,68 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <unordered_set>
+#include <vector>
+
+#include "BVH.h"
+#include "Collision.h"
+#include "SceneNode.h"
+#include "SchoolBuilder.h"
+
+// Result of a scene ray query
+struct RayHit
+{
+    MeshNode* node = nullptr; // closest mesh hit
+    float distance = 0.0f;    // along the (normalized) ray direction
+    glm::vec3 point = glm::vec3(0.0f);
+    glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f); // world-space surface normal at the hit
+};
+
+// Ray-query service over every MeshNode in a scene.
+// Meshes are split in two layers, each with its own BVH over world AABBs:
+// - static: built once
+// - dynamic: meshes under the given animated roots (people, cars, doors, ...), rebuilt by
+//   UpdateDynamic() after the frame's transforms are updated (a few hundred boxes, cheap)
+// Candidates are tested exactly against the mesh's oriented unit box in local space, which
+// gives the hit distance and the face normal.
+class SceneBVH
+{
+public:
+    void Build(const SceneNode::Ptr& root, const std::vector<SceneNode::Ptr>& dynamicRoots = {});
+
+    // Re-reads the dynamic meshes' global transforms and rebuilds the dynamic layer.
+    void UpdateDynamic();
+
+    // Closest hit along origin + t * dir with t in [0, maxDistance]. dir must be normalized.
+    bool Raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance, RayHit& hit) const;
+
+    size_t GetStaticCount() const { return staticLayer.meshes.size(); }
+    size_t GetDynamicCount() const { return dynamicLayer.meshes.size(); }
+
+private:
+    struct Layer
+    {
+        BVH bvh;
+        std::vector<MeshNode*> meshes;
+        std::vector<AABB> boxes;
+
+        void Rebuild();
+    };
+
+    static void Collect(const SceneNode::Ptr& node, bool dynamic,
+                        const std::unordered_set<const SceneNode*>& dynamicRoots, Layer& staticOut, Layer& dynamicOut);
+
+    // World AABB of a mesh's local bounds
+    static AABB WorldBounds(const MeshNode& mesh);
+
+    // Exact ray test against the mesh's oriented local bounds
+    static bool IntersectMesh(const MeshNode& mesh, const glm::vec3& origin, const glm::vec3& dir,
+                              float tMax, float& t, glm::vec3& normal);
+
+    static void RaycastLayer(const Layer& layer, const glm::vec3& origin, const glm::vec3& dir,
+                             float& tMax, RayHit& hit);
+
+    Layer staticLayer;
+    Layer dynamicLayer;
+};
@@ -1,36 +1,166 @@
 #include "SceneNode.h"
+#include "TransformHierarchy.h"
 #include <algorithm>
 
 SceneNode::SceneNode()
-    : localTransform(1.0f),
-      globalTransform(1.0f)
 {
 }
 
 SceneNode::SceneNode(const glm::mat4& local)
-    : localTransform(local),
-      globalTransform(1.0f)
 {
+    SetLocalTransform(local);
 }
 
-SceneNode::~SceneNode() = default;
+SceneNode::SceneNode(NodeKind kind, const glm::mat4& local)
+    : kind(kind)
+{
+    SetLocalTransform(local);
+}
+
+SceneNode::~SceneNode()
+{
+    // Never leave a dangling pointer (or a soon reused mesh id) in the flat hierarchy
+    if (hierarchy)
+    {
+        hierarchy->nodes[hierarchyIndex] = nullptr;
+        hierarchy->meshIds[hierarchyIndex] = MeshTable::kNoMesh;
+    }
+
+    // Children still referenced elsewhere outlive this node
+    for (auto& c : children)
+    {
+        if (c) c->parent = nullptr;
+    }
+}
+
+glm::mat4 SceneNode::GetLocalTransform() const
+{
+    const Affine3x4* sheared = GetShearedLocal();
+    return sheared ? sheared->ToMat4() : ComposeTRS(GetLocalTRS()).ToMat4();
+}
+
+void SceneNode::SetLocalTransform(const glm::mat4& t)
+{
+    TRS trs;
+    if (DecomposeTRS(t, trs))
+    {
+        SetLocal(trs, nullptr);
+        return;
+    }
+
+    // Sheared: keep the matrix, and a TRS approximation so the part setters have a base
+    trs.position = glm::vec3(t[3]);
+    trs.scale = glm::vec3(glm::length(glm::vec3(t[0])), glm::length(glm::vec3(t[1])), glm::length(glm::vec3(t[2])));
+    const Affine3x4 sheared = Affine3x4::FromMat4(t);
+    SetLocal(trs, &sheared);
+}
+
+const TRS& SceneNode::GetLocalTRS() const
+{
+    return hierarchy ? hierarchy->locals[hierarchyIndex] : localTRS;
+}
+
+void SceneNode::SetLocalTRS(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale)
+{
+    SetLocal(TRS{ position, rotation, scale }, nullptr);
+}
+
+void SceneNode::SetLocalPosition(const glm::vec3& position)
+{
+    TRS trs = GetLocalTRS();
+    trs.position = position;
+    if (const Affine3x4* current = GetShearedLocal())
+    {
+        // Translation is independent of the shear
+        Affine3x4 sheared = *current;
+        sheared.SetTranslation(position);
+        SetLocal(trs, &sheared);
+        return;
+    }
+    SetLocal(trs, nullptr);
+}
+
+void SceneNode::SetLocalRotation(const glm::quat& rotation)
+{
+    TRS trs = GetLocalTRS();
+    trs.rotation = rotation;
+    SetLocal(trs, nullptr);
+}
+
+void SceneNode::SetLocalScale(const glm::vec3& scale)
+{
+    TRS trs = GetLocalTRS();
+    trs.scale = scale;
+    SetLocal(trs, nullptr);
+}
+
+const Affine3x4* SceneNode::GetShearedLocal() const
+{
+    return hierarchy ? hierarchy->FindShearedLocal(hierarchyIndex) : shearedLocal.get();
+}
+
+void SceneNode::SetLocal(const TRS& trs, const Affine3x4* sheared)
+{
+    if (hierarchy)
+    {
+        hierarchy->SetLocal(hierarchyIndex, trs, sheared);
+        return;
+    }
+    localTRS = trs;
+    if (sheared) shearedLocal = std::make_unique<Affine3x4>(*sheared);
+    else shearedLocal.reset();
+    MarkTransformDirty();
+}
+
+void SceneNode::MarkTransformDirty()
+{
+    transformDirty = true;
+
+    // Walk up until an ancestor already knows it has a dirty descendant
+    SceneNode* p = parent;
+    while (p && !p->childDirty)
+    {
+        p->childDirty = true;
+        p = p->parent;
+    }
+}
+
+glm::mat4 SceneNode::GetGlobalTransform() const
+{
+    return GetGlobalAffine().ToMat4();
+}
+
+const Affine3x4& SceneNode::GetGlobalAffine() const
+{
+    return hierarchy ? hierarchy->globals[hierarchyIndex] : globalTransform;
+}
+
+void SceneNode::SetGlobalTransform(const Affine3x4& t)
+{
+    if (hierarchy) hierarchy->globals[hierarchyIndex] = t;
+    else globalTransform = t;
+}
 
 void SceneNode::AddChild(const Ptr& child)
 {
     if (!child) return;
-    // Avoid adding the same shared_ptr twice.
+    // Avoid adding the same node twice.
     auto it = std::find(children.begin(), children.end(), child);
     if (it != children.end()) return;
 
     children.push_back(child);
-    child->parent = shared_from_this();
+    child->parent = this;
+    child->MarkTransformDirty(); // re-parented: its globals are stale
+    if (hierarchy) hierarchy->MarkStructureChanged();
 }
 
 SceneNode::Ptr SceneNode::CreateChild()
 {
-    Ptr child = std::make_shared<SceneNode>();
+    Ptr child = MakeNode<SceneNode>();
     children.push_back(child);
-    child->parent = shared_from_this();
+    child->parent = this;
+    child->MarkTransformDirty();
+    if (hierarchy) hierarchy->MarkStructureChanged();
     return child;
 }
 
@@ -40,32 +170,55 @@ bool SceneNode::RemoveChild(const Ptr& child)
     auto it = std::find(children.begin(), children.end(), child);
     if (it == children.end()) return false;
 
-    // clear parent and erase
-    (*it)->parent.reset();
+    // clear parent and erase (the removed subtree leaves the flat hierarchy immediately)
+    if (hierarchy)
+    {
+        hierarchy->Detach(it->get());
+        hierarchy->MarkStructureChanged();
+    }
+    (*it)->parent = nullptr;
     children.erase(it);
     return true;
 }
 
-void SceneNode::updateGlobalTransform(const glm::mat4& parentTransform)
+size_t SceneNode::updateGlobalTransform(const glm::mat4& parentTransform)
 {
-    // global = parent * local
-    globalTransform = parentTransform * localTransform;
+    return UpdateDirty(Affine3x4::FromMat4(parentTransform), true);
+}
 
-    // propagate to children
-    for (auto& c : children)
+size_t SceneNode::updateGlobalTransform()
+{
+    if (parent)
     {
-        if (c) c->updateGlobalTransform(globalTransform);
+        return UpdateDirty(parent->GetGlobalAffine(), false);
+    }
+    else
+    {
+        return UpdateDirty(Affine3x4(), false);
     }
 }
 
-void SceneNode::updateGlobalTransform()
+size_t SceneNode::UpdateDirty(const Affine3x4& parentTransform, bool parentChanged)
 {
-    if (auto p = parent.lock())
+    // Clean subtree: nothing below here moved
+    if (!parentChanged && !transformDirty && !childDirty) return 0;
+
+    size_t count = 0;
+    const bool changed = parentChanged || transformDirty;
+    if (changed)
     {
-        updateGlobalTransform(p->GetGlobalTransform());
+        // global = parent * local
+        const Affine3x4* sheared = GetShearedLocal();
+        SetGlobalTransform(MultiplyAffine(parentTransform, sheared ? *sheared : ComposeTRS(GetLocalTRS())));
+        ++count;
     }
-    else
+    transformDirty = false;
+    childDirty = false;
+
+    // propagate to children (a changed global forces the whole subtree)
+    for (auto& c : children)
     {
-        updateGlobalTransform(glm::mat4(1.0f));
+        if (c) count += c->UpdateDirty(GetGlobalAffine(), changed);
     }
-}
\ No newline at end of file
+    return count;
+}
@@ -1,30 +1,42 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstdint>
+#include <utility>
 #include <vector>
-#include <memory>
 
-class SceneNode : public std::enable_shared_from_this<SceneNode>
+#include "Collision.h"
+#include "SceneArena.h"
+#include "Transform.h"
+
+class TransformHierarchy;
+
+// Type tag of a scene node, so traversals can tell node types apart without RTTI
+enum class NodeKind : uint8_t
+{
+    Group, // plain transform node
+    Mesh   // MeshNode
+};
+
+// Nodes live in the SceneArena: create them with MakeNode<T>() and hold them through Ptr.
+class SceneNode
 {
 public:
-    using Ptr = std::shared_ptr<SceneNode>;
+    using Ptr = NodeRef<SceneNode>;
 
     SceneNode();
     explicit SceneNode(const glm::mat4& local);
 
-    // Make class polymorphic so dynamic_cast / dynamic_pointer_cast works.
     virtual ~SceneNode();
 
-    // Parent is a weak_ptr to avoid ownership cycles.
-    std::weak_ptr<SceneNode> parent;
+    NodeKind GetKind() const { return kind; }
+
+    // Non-owning; cleared when the parent removes or releases this node.
+    SceneNode* parent = nullptr;
 
     // Children are owned by this node.
     std::vector<Ptr> children;
 
-    // Local and cached global transform
-    glm::mat4 localTransform;
-    glm::mat4 globalTransform;
-
     // Adds an existing child (will set its parent to this)
     void AddChild(const Ptr& child);
 
@@ -35,20 +47,106 @@ public:
     bool RemoveChild(const Ptr& child);
 
     // Getters / setters
-    const glm::mat4& GetLocalTransform() const { return localTransform; }
-    void SetLocalTransform(const glm::mat4& t) { localTransform = t; }
+    // When the node is compiled into a TransformHierarchy these access its flat arrays.
+    // Every setter marks this subtree dirty; only dirty subtrees are recomputed.
+    // Locals are stored as TRS and composed into matrices by the update pass. A matrix that
+    // is not T * R * S (a non-uniform scale under a rotation shears) is kept as a full affine
+    // matrix instead; its TRS then only holds its translation and column lengths.
+    glm::mat4 GetLocalTransform() const;
+    void SetLocalTransform(const glm::mat4& t);
+
+    const TRS& GetLocalTRS() const;
+    void SetLocalTRS(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale = glm::vec3(1.0f));
+
+    // Animation setters: change one part and keep the others.
+    // Rotation and scale replace a sheared matrix by its TRS with that part swapped in.
+    void SetLocalPosition(const glm::vec3& position);
+    void SetLocalRotation(const glm::quat& rotation);
+    void SetLocalScale(const glm::vec3& scale);
 
-    const glm::mat4& GetGlobalTransform() const { return globalTransform; }
+    glm::mat4 GetGlobalTransform() const;
+    const Affine3x4& GetGlobalAffine() const;
 
     // Update global transform by multiplying parent's global transform with local transform,
-    // store it in this node, and propagate to children.
-    void updateGlobalTransform(const glm::mat4& parentTransform);
+    // store it in this node, and propagate to children (always recomputes the whole subtree).
+    // Returns the number of global transforms recomputed.
+    size_t updateGlobalTransform(const glm::mat4& parentTransform);
 
     // Convenience: update using the actual parent (or identity if none).
-    void updateGlobalTransform();
+    // Incremental: only subtrees marked dirty since the last update are recomputed.
+    size_t updateGlobalTransform();
+
+    // Local-space bounds of what this node draws itself (not its children).
+    // Returns false for nodes without geometry; TransformHierarchy keeps world and subtree bounds from it.
+    virtual bool GetLocalBounds(AABB& out) const { (void)out; return false; }
+
+    // True while this node's transforms live in a TransformHierarchy
+    bool IsCompiled() const { return hierarchy != nullptr; }
+
+protected:
+    // For subclasses: tags the node with their kind
+    SceneNode(NodeKind kind, const glm::mat4& local);
 
 private:
-    // Non-copyable semantics (shared_ptr used for ownership)
+    friend class TransformHierarchy;
+
+    // Local and cached global transform (authoritative only while not compiled)
+    TRS localTRS;
+    std::unique_ptr<Affine3x4> shearedLocal; // set when the local matrix is not a TRS
+    Affine3x4 globalTransform;
+
+    // Flat hierarchy this node is compiled into (nullptr if none) and its index there
+    TransformHierarchy* hierarchy = nullptr;
+    uint32_t hierarchyIndex = 0;
+
+    NodeKind kind = NodeKind::Group;
+
+    // Dirty tracking for the (non-compiled) recursive update path:
+    // transformDirty = local changed; childDirty = some descendant is dirty.
+    bool transformDirty = true;
+    bool childDirty = false;
+
+    // nullptr unless the local matrix is sheared
+    const Affine3x4* GetShearedLocal() const;
+
+    // All local setters end here; sheared may be null
+    void SetLocal(const TRS& trs, const Affine3x4* sheared);
+
+    void SetGlobalTransform(const Affine3x4& t);
+
+    // Marks this node dirty and flags its ancestors so the update pass descends to it.
+    void MarkTransformDirty();
+
+    size_t UpdateDirty(const Affine3x4& parentTransform, bool parentChanged);
+
+    // Non-copyable semantics (nodes are shared through Ptr)
     SceneNode(const SceneNode&) = delete;
     SceneNode& operator=(const SceneNode&) = delete;
-};
\ No newline at end of file
+};
+
+// Allocates a node in the scene arena (the replacement for std::make_shared<T>)
+template <typename T, typename... Args>
+NodeRef<T> MakeNode(Args&&... args)
+{
+    return NodeRef<T>(SceneArena::Get().Create<T>(std::forward<Args>(args)...));
+}
+
+// Checked downcast on the kind tag (no RTTI, no reference counting): node as a T, or nullptr
+template <typename T>
+T* NodeCast(SceneNode* node)
+{
+    return node && node->GetKind() == T::kKind ? static_cast<T*>(node) : nullptr;
+}
+
+template <typename T>
+const T* NodeCast(const SceneNode* node)
+{
+    return node && node->GetKind() == T::kKind ? static_cast<const T*>(node) : nullptr;
+}
+
+// Same for handles: a new reference to the node if it is a T, else null
+template <typename T>
+NodeRef<T> NodeCast(const SceneNode::Ptr& ref)
+{
+    return NodeCast<T>(ref.get()) ? NodeRef<T>(ref.GetHandle()) : NodeRef<T>();
+}
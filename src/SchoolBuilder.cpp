@@ -5,10 +5,10 @@
 #include <string>
 
 // Helper to create a simple cuboid
-static std::shared_ptr<MeshNode> createCuboid(glm::vec3 size, glm::vec3 color, glm::vec3 pos)
+static MeshNode::Ptr createCuboid(glm::vec3 size, glm::vec3 color, glm::vec3 pos)
 {
-    auto node = std::make_shared<MeshNode>(MeshType::Cube);
-    node->material.albedo = color;
+    auto node = MakeNode<MeshNode>(MeshType::Cube);
+    node->SetAlbedo(color);
     
     glm::mat4 t(1.0f);
     t = glm::translate(t, pos);
@@ -19,7 +19,7 @@ static std::shared_ptr<MeshNode> createCuboid(glm::vec3 size, glm::vec3 color, g
 
 // Helper to create a simple car
 static SceneNode::Ptr createCar(glm::vec3 color) {
-    auto carNode = std::make_shared<SceneNode>();
+    auto carNode = MakeNode<SceneNode>();
     
     // Chassis (Body)
     auto chassis = createCuboid(glm::vec3(4.5f, 1.0f, 2.0f), color, glm::vec3(0.0f, 0.7f, 0.0f));
@@ -44,8 +44,8 @@ static SceneNode::Ptr createCar(glm::vec3 color) {
     // Rotate 90 deg around X axis.
     
     auto createWheel = [&](float x, float z) {
-        auto wheel = std::make_shared<MeshNode>(MeshType::Cylinder); // Cylinder Mesh
-        wheel->material.albedo = wheelColor;
+        auto wheel = MakeNode<MeshNode>(MeshType::Cylinder); // Cylinder Mesh
+        wheel->SetAlbedo(wheelColor);
         
         // Initial Transform (No rotation yet, just placement and orientation)
         glm::mat4 t(1.0f);
@@ -89,7 +89,7 @@ static SceneNode::Ptr createCar(glm::vec3 color) {
 // returns a SceneNode containing frame and glass
 static SceneNode::Ptr createWindow(float width, float height)
 {
-    auto winNode = std::make_shared<SceneNode>();
+    auto winNode = MakeNode<SceneNode>();
     
     float frameThickness = 0.1f;
     float glassDepth = 0.05f;
@@ -147,10 +147,10 @@ static SceneNode::Ptr createWindow(float width, float height)
 static SceneNode::Ptr createDoor(float width, float height, float openAngle = 90.0f)
 {
     // Root Node (Fixed position in wall)
-    auto doorRoot = std::make_shared<SceneNode>();
+    auto doorRoot = MakeNode<SceneNode>();
     
     // Hinge Node (Rotates)
-    auto doorHinge = std::make_shared<SceneNode>();
+    auto doorHinge = MakeNode<SceneNode>();
     doorRoot->AddChild(doorHinge);
     
     glm::vec3 doorColor(0.4f, 0.25f, 0.1f); // Wood color
@@ -226,7 +226,7 @@ void SchoolBuilder::toggleDoor(const glm::vec3& playerPos, float maxDistance, co
 
 static SceneNode::Ptr createTable(float width, float depth, float height)
 {
-    auto table = std::make_shared<SceneNode>();
+    auto table = MakeNode<SceneNode>();
     glm::vec3 woodColor(0.6f, 0.4f, 0.2f);
     
     // Tabletop
@@ -247,7 +247,7 @@ static SceneNode::Ptr createTable(float width, float depth, float height)
 
 static SceneNode::Ptr createChair(float size)
 {
-    auto chair = std::make_shared<SceneNode>();
+    auto chair = MakeNode<SceneNode>();
     glm::vec3 woodColor(0.5f, 0.35f, 0.15f);
     float seatH = 0.45f;
     
@@ -272,10 +272,10 @@ static SceneNode::Ptr createChair(float size)
 
 static SceneNode::Ptr createBlackboard(float width, float height)
 {
-    auto boardGroup = std::make_shared<SceneNode>();
+    auto boardGroup = MakeNode<SceneNode>();
     
     // Board Node (Frame + Surface)
-    auto board = std::make_shared<SceneNode>();
+    auto board = MakeNode<SceneNode>();
     
     // Frame
     glm::vec3 frameColor(0.3f, 0.2f, 0.1f);
@@ -322,7 +322,7 @@ static SceneNode::Ptr createBlackboard(float width, float height)
 
 static SceneNode::Ptr createPodium()
 {
-    auto podium = std::make_shared<SceneNode>();
+    auto podium = MakeNode<SceneNode>();
     glm::vec3 woodColor(0.55f, 0.35f, 0.2f);
     
     // Base Box
@@ -334,7 +334,7 @@ static SceneNode::Ptr createPodium()
 // Helper: Create a large, complex tree
 static SceneNode::Ptr createTree(float height = 6.5f)
 {
-    auto tree = std::make_shared<SceneNode>();
+    auto tree = MakeNode<SceneNode>();
     
     // Trunk (very thick, dark brown)
     glm::vec3 trunkColor(0.3f, 0.18f, 0.08f);  // Very dark brown
@@ -470,7 +470,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
                                   int maskStart = 1, // Number of slots to mask (no window) from start
                                   int maskEnd = 1)   // Number of slots to mask (no window) from end
 {
-    auto wing = std::make_shared<SceneNode>();
+    auto wing = MakeNode<SceneNode>();
     
     // Materials
     glm::vec3 wallColor(0.9f, 0.85f, 0.8f); // Cream/White wall
@@ -478,6 +478,13 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
     glm::vec3 roofColor(0.7f, 0.3f, 0.3f); // Red roof
     glm::vec3 pillarColor(0.85f, 0.8f, 0.75f); // Slightly darker for pillars
     
+    // Solid wall pieces are also occluders for the software occlusion culling
+    auto addOccluder = [&](glm::vec3 size, glm::vec3 color, glm::vec3 pos) {
+        auto node = createCuboid(size, color, pos);
+        node->SetOccluder(true);
+        wing->AddChild(node);
+    };
+
     // Dimensions
     float wallThick = 0.2f;
     float floorThick = 0.2f;
@@ -490,6 +497,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
         wallColor,
         glm::vec3(0.0f, h/2.0f, -d/2.0f + wallThick/2.0f)
     );
+    backWall->SetOccluder(true);
     wing->AddChild(backWall);
     
     // Left Wall (Solid side)
@@ -498,6 +506,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
         wallColor,
         glm::vec3(-w/2.0f + wallThick/2.0f, h/2.0f, 0.0f)
     );
+    leftWall->SetOccluder(true);
     wing->AddChild(leftWall);
     
     // Right Wall (Solid side)
@@ -506,6 +515,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
         wallColor,
         glm::vec3(w/2.0f - wallThick/2.0f, h/2.0f, 0.0f)
     );
+    rightWall->SetOccluder(true);
     wing->AddChild(rightWall);
     
     // Floor 1 (Ground)
@@ -514,6 +524,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
         floorColor,
         glm::vec3(0.0f, floorThick/2.0f, 0.0f)
     );
+    floor1->SetOccluder(true);
     wing->AddChild(floor1);
     
     // Ceiling / Roof Base
@@ -522,6 +533,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
         wallColor,
         glm::vec3(0.0f, h - floorThick/2.0f, 0.0f)
     );
+    ceiling->SetOccluder(true);
     wing->AddChild(ceiling);
     
     // Slanted Roof Top
@@ -532,6 +544,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
         roofColor, 
         glm::vec3(0.0f, h + roofH/2.0f, 0.0f)
     );
+    roof->SetOccluder(true);
     wing->AddChild(roof);
 
     // Floor 2 (Intermediate) - If 2-story
@@ -544,6 +557,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
             floorColor,
             glm::vec3(0.0f, floor2Y - floorThick/2.0f, 0.0f)
         );
+        floor2->SetOccluder(true);
         wing->AddChild(floor2);
         
         // Internal Staircase REMOVED as requested
@@ -641,6 +655,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
                     wallColor,
                     glm::vec3(currentX, doorH + lintelH/2.0f, frontZ)
                 );
+                lintel->SetOccluder(true);
                 wing->AddChild(lintel);
             }
             
@@ -648,17 +663,17 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
             float sideGap = (slotWidth - actualDoorW) / 2.0f;
             if (sideGap > 0.05f) {
                 // Left Jamb
-                wing->AddChild(createCuboid(
+                addOccluder(
                     glm::vec3(sideGap, doorH, wallThick),
                     wallColor,
                     glm::vec3(currentX - actualDoorW/2.0f - sideGap/2.0f, doorH/2.0f, frontZ)
-                ));
+                );
                 // Right Jamb
-                wing->AddChild(createCuboid(
+                addOccluder(
                     glm::vec3(sideGap, doorH, wallThick),
                     wallColor,
                     glm::vec3(currentX + actualDoorW/2.0f + sideGap/2.0f, doorH/2.0f, frontZ)
-                ));
+                );
             }
             
                 // 3. The Door Object(s)
@@ -781,11 +796,11 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
             if ((withWindows && !isIntersection) || forceWindow) {
                 // Wall Below Window
                 float belowH = winY1 - winH/2.0f;
-                wing->AddChild(createCuboid(
+                addOccluder(
                     glm::vec3(slotWidth, belowH, wallThick),
                     wallColor,
                     glm::vec3(currentX, belowH/2.0f, frontZ)
-                ));
+                );
                 
                 // The Window
                 auto winObj = createWindow(winW, winH);
@@ -798,19 +813,19 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
                 float heightAbove = topY - baseWinTop;
                 
                 if (heightAbove > 0) {
-                    wing->AddChild(createCuboid(
+                    addOccluder(
                         glm::vec3(slotWidth, heightAbove, wallThick),
                         wallColor,
                         glm::vec3(currentX, baseWinTop + heightAbove/2.0f, frontZ)
-                    ));
+                    );
                 }
             } else {
                 // Solid Wall Slot (No Window)
-                wing->AddChild(createCuboid(
+                addOccluder(
                      glm::vec3(slotWidth, floor2Y, wallThick),
                      wallColor,
                      glm::vec3(currentX, floor2Y/2.0f, frontZ)
-                ));
+                );
             }
         }
         
@@ -844,28 +859,28 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
                 // 1. Lintel above door
                 float lintelH = (h - floor2Y) - doorH; 
                 if (lintelH > 0) {
-                    wing->AddChild(createCuboid(
+                    addOccluder(
                         glm::vec3(slotWidth, lintelH, wallThick),
                         wallColor,
                         glm::vec3(currentX, floor2Y + doorH + lintelH/2.0f, frontZ)
-                    ));
+                    );
                 }
                 
                 // 2. Side Walls (Jambs) to fill the gap (Door=1.0, Slot=2.5)
                 float sideGap = (slotWidth - doorW) / 2.0f;
                 if (sideGap > 0.05f) {
                     // Left Jamb
-                    wing->AddChild(createCuboid(
+                    addOccluder(
                         glm::vec3(sideGap, doorH, wallThick),
                         wallColor,
                         glm::vec3(currentX - doorW/2.0f - sideGap/2.0f, floor2Y + doorH/2.0f, frontZ)
-                    ));
+                    );
                     // Right Jamb
-                    wing->AddChild(createCuboid(
+                    addOccluder(
                         glm::vec3(sideGap, doorH, wallThick),
                         wallColor,
                         glm::vec3(currentX + doorW/2.0f + sideGap/2.0f, floor2Y + doorH/2.0f, frontZ)
-                    ));
+                    );
                 }
                 
                 // 3. The Door Object
@@ -953,11 +968,11 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
                     float belowH = winBottom - baseH;
                     
                     if (belowH > 0) {
-                        wing->AddChild(createCuboid(
+                        addOccluder(
                             glm::vec3(slotWidth, belowH, wallThick),
                             wallColor,
                             glm::vec3(currentX, baseH + belowH/2.0f, frontZ)
-                        ));
+                        );
                     }
                     
                     // Window
@@ -970,20 +985,20 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
                     float heightAbove = h - winTop;
                     
                     if (heightAbove > 0) {
-                        wing->AddChild(createCuboid(
+                        addOccluder(
                             glm::vec3(slotWidth, heightAbove, wallThick),
                             wallColor,
                             glm::vec3(currentX, winTop + heightAbove/2.0f, frontZ)
-                        ));
+                        );
                     }
                  } else {
                      // Solid Wall
                      float height = h - floor2Y;
-                     wing->AddChild(createCuboid(
+                     addOccluder(
                          glm::vec3(slotWidth, height, wallThick),
                          wallColor,
                          glm::vec3(currentX, floor2Y + height/2.0f, frontZ)
-                    ));
+                    );
                  }
              }
         }
@@ -1091,7 +1106,7 @@ static SceneNode::Ptr createWing(float w, float h, float d, bool withWindows, bo
 // Create a parabolic arch gate inspired by Bach Khoa (HUST) entrance
 static SceneNode::Ptr createParabolicArchGate(float width, float archHeight)
 {
-    auto gateNode = std::make_shared<SceneNode>();
+    auto gateNode = MakeNode<SceneNode>();
     
     // White concrete color for the iconic arch
     glm::vec3 archColor(0.95f, 0.95f, 0.97f); // Bright white concrete
@@ -1125,8 +1140,8 @@ static SceneNode::Ptr createParabolicArchGate(float width, float archHeight)
         float angle = std::atan2(dy, dx);
         
         // Create segment
-        auto segment = std::make_shared<MeshNode>(MeshType::Cube);
-        segment->material.albedo = archColor;
+        auto segment = MakeNode<MeshNode>(MeshType::Cube);
+        segment->SetAlbedo(archColor);
         
         glm::mat4 t_mat(1.0f);
         t_mat = glm::translate(t_mat, glm::vec3(x + dx/2.0f, y + dy/2.0f, 0.0f));
@@ -1169,7 +1184,7 @@ static SceneNode::Ptr createParabolicArchGate(float width, float archHeight)
 // Create a complete perimeter wall/fence system enclosing the school grounds
 static SceneNode::Ptr createPerimeterWall(float width, float depth)
 {
-    auto wallNode = std::make_shared<SceneNode>();
+    auto wallNode = MakeNode<SceneNode>();
     
     // Wall parameters
     glm::vec3 brickColor(0.7f, 0.5f, 0.4f); // Reddish brick
@@ -1356,7 +1371,7 @@ static SceneNode::Ptr createPerimeterWall(float width, float depth)
 // Create a modern streetlight
 static SceneNode::Ptr createStreetlight(float height)
 {
-    auto light = std::make_shared<SceneNode>();
+    auto light = MakeNode<SceneNode>();
     
     // Pole (dark metal)
     float poleHeight = height;
@@ -1395,7 +1410,7 @@ static SceneNode::Ptr createStreetlight(float height)
 }
 
 static SceneNode::Ptr createIronGate(float width, float height) {
-    auto gate = std::make_shared<SceneNode>();
+    auto gate = MakeNode<SceneNode>();
     
     // Frame
     float frameThick = 0.15f;
@@ -1421,13 +1436,13 @@ static SceneNode::Ptr createIronGate(float width, float height) {
 }
 
 static SceneNode::Ptr createLeverObj() {
-    auto leverNode = std::make_shared<SceneNode>();
+    auto leverNode = MakeNode<SceneNode>();
     
     // Base
     leverNode->AddChild(createCuboid(glm::vec3(0.4f, 0.1f, 0.4f), glm::vec3(0.3f), glm::vec3(0, 0.05f, 0)));
     
     // Handle (Pivot point)
-    auto handle = std::make_shared<SceneNode>();
+    auto handle = MakeNode<SceneNode>();
     // Stick
     handle->AddChild(createCuboid(glm::vec3(0.05f, 0.6f, 0.05f), glm::vec3(0.8f, 0.0f, 0.0f), glm::vec3(0, 0.3f, 0)));
     // Knob
@@ -1443,7 +1458,7 @@ static SceneNode::Ptr createLeverObj() {
 // Helper to create a flagpole with waving Vietnamese flag
 static SceneNode::Ptr createFlagpole(float height = 10.0f)
 {
-    auto flagpoleNode = std::make_shared<SceneNode>();
+    auto flagpoleNode = MakeNode<SceneNode>();
     
     // Clear old flag parts if any
     SchoolBuilder::s_flagParts.clear();
@@ -1594,7 +1609,7 @@ int starGrid[31][31] = {
 // Helper to create a classical statue on a pedestal
 static SceneNode::Ptr createStatue()
 {
-    auto statueNode = std::make_shared<SceneNode>();
+    auto statueNode = MakeNode<SceneNode>();
     
     // Color palette
     glm::vec3 stoneGray(0.55f, 0.55f, 0.58f);      // Base stone
@@ -2027,7 +2042,7 @@ static SceneNode::Ptr createStatue()
 // Helper to create interactive light control panel
 static SceneNode::Ptr createControlPanel()
 {
-    auto panelNode = std::make_shared<SceneNode>();
+    auto panelNode = MakeNode<SceneNode>();
     
     // Colors
     glm::vec3 panelGray(0.3f, 0.3f, 0.35f);      // Dark gray panel
@@ -2107,7 +2122,7 @@ static SceneNode::Ptr createControlPanel()
 // Helper to create a multi-tiered fountain
 static SceneNode::Ptr createFountain()
 {
-    auto fountainNode = std::make_shared<SceneNode>();
+    auto fountainNode = MakeNode<SceneNode>();
     
     // Color palette
     glm::vec3 stoneGray(0.6f, 0.6f, 0.65f);        // Main stone
@@ -2456,7 +2471,7 @@ static SceneNode::Ptr createFountain()
 // Helper to create a stone bench
 static SceneNode::Ptr createStoneBench()
 {
-    auto benchNode = std::make_shared<SceneNode>();
+    auto benchNode = MakeNode<SceneNode>();
     
     glm::vec3 stoneGray(0.6f, 0.6f, 0.65f);
     glm::vec3 stoneDark(0.4f, 0.4f, 0.45f);
@@ -2494,7 +2509,7 @@ static SceneNode::Ptr createStoneBench()
 // Helper to create picnic table
 static SceneNode::Ptr createPicnicTable()
 {
-    auto tableNode = std::make_shared<SceneNode>();
+    auto tableNode = MakeNode<SceneNode>();
     
     glm::vec3 woodBrown(0.55f, 0.35f, 0.2f);
     glm::vec3 woodDark(0.35f, 0.25f, 0.15f);
@@ -2544,7 +2559,7 @@ static SceneNode::Ptr createPicnicTable()
 // Helper to create a simple person with articulated limbs for walking animation
 static SceneNode::Ptr createPerson(glm::vec3 shirtColor = glm::vec3(0.3f, 0.5f, 0.8f))
 {
-    auto personNode = std::make_shared<SceneNode>();
+    auto personNode = MakeNode<SceneNode>();
     
     glm::vec3 skinColor(0.9f, 0.7f, 0.6f);
     glm::vec3 pantsColor(0.2f, 0.2f, 0.3f);
@@ -2587,7 +2602,7 @@ static SceneNode::Ptr createPerson(glm::vec3 shirtColor = glm::vec3(0.3f, 0.5f,
     float shoulderY = personHeight - headRadius * 2 - 0.05f;
     
     // Left arm (upper + lower)
-    auto leftArmUpper = std::make_shared<SceneNode>();
+    auto leftArmUpper = MakeNode<SceneNode>();
     auto leftArmUpperMesh = createCuboid(
         glm::vec3(0.06f, upperArmLength, 0.06f),
         shirtColor,
@@ -2606,7 +2621,7 @@ static SceneNode::Ptr createPerson(glm::vec3 shirtColor = glm::vec3(0.3f, 0.5f,
     personNode->AddChild(leftArmUpper);
     
     // Right arm (upper + lower)
-    auto rightArmUpper = std::make_shared<SceneNode>();
+    auto rightArmUpper = MakeNode<SceneNode>();
     auto rightArmUpperMesh = createCuboid(
         glm::vec3(0.06f, upperArmLength, 0.06f),
         shirtColor,
@@ -2628,7 +2643,7 @@ static SceneNode::Ptr createPerson(glm::vec3 shirtColor = glm::vec3(0.3f, 0.5f,
     float hipY = personHeight - headRadius * 2 - bodyHeight;
     
     // Left leg (upper + lower)
-    auto leftLegUpper = std::make_shared<SceneNode>();
+    auto leftLegUpper = MakeNode<SceneNode>();
     auto leftLegUpperMesh = createCuboid(
         glm::vec3(0.08f, upperLegHeight, 0.08f),
         pantsColor,
@@ -2654,7 +2669,7 @@ static SceneNode::Ptr createPerson(glm::vec3 shirtColor = glm::vec3(0.3f, 0.5f,
     personNode->AddChild(leftLegUpper);
     
     // Right leg (upper + lower)
-    auto rightLegUpper = std::make_shared<SceneNode>();
+    auto rightLegUpper = MakeNode<SceneNode>();
     auto rightLegUpperMesh = createCuboid(
         glm::vec3(0.08f, upperLegHeight, 0.08f),
         pantsColor,
@@ -2688,7 +2703,7 @@ static SceneNode::Ptr createPerson(glm::vec3 shirtColor = glm::vec3(0.3f, 0.5f,
 // Helper to create a wall-mounted clock (no tower, no second hand)
 static SceneNode::Ptr createClock()
 {
-    auto clockNode = std::make_shared<SceneNode>();
+    auto clockNode = MakeNode<SceneNode>();
     
     glm::vec3 clockFaceColor(0.95f, 0.95f, 0.95f); // White
     glm::vec3 handColor(0.1f, 0.1f, 0.1f); // Black
@@ -2732,7 +2747,7 @@ static SceneNode::Ptr createClock()
     }
     
     // Hour hand (short, thick) - as separate node for animation
-    auto hourHand = std::make_shared<SceneNode>();
+    auto hourHand = MakeNode<SceneNode>();
     auto hourHandMesh = createCuboid(
         glm::vec3(0.04f, clockRadius * 0.45f, 0.04f),
         handColor,
@@ -2744,7 +2759,7 @@ static SceneNode::Ptr createClock()
     clockNode->AddChild(hourHand);
     
     // Minute hand (longer, thinner) - as separate node for animation
-    auto minuteHand = std::make_shared<SceneNode>();
+    auto minuteHand = MakeNode<SceneNode>();
     auto minuteHandMesh = createCuboid(
         glm::vec3(0.03f, clockRadius * 0.7f, 0.04f),
         handColor,
@@ -2764,7 +2779,7 @@ static SceneNode::Ptr createClock()
 // Helper to create a simple cloud
 static SceneNode::Ptr createCloud(float size = 1.0f)
 {
-    auto cloudNode = std::make_shared<SceneNode>();
+    auto cloudNode = MakeNode<SceneNode>();
     
     glm::vec3 cloudColor(0.95f, 0.95f, 0.98f); // Light white/blue
     
@@ -2815,7 +2830,7 @@ static SceneNode::Ptr createCloud(float size = 1.0f)
 // Helper to create a simple bird (V-shape)
 static SceneNode::Ptr createBird(float size = 0.5f, const glm::vec3& color = glm::vec3(0.2f, 0.2f, 0.2f))
 {
-    auto birdNode = std::make_shared<SceneNode>();
+    auto birdNode = MakeNode<SceneNode>();
     
     // Left wing
     auto leftWing = createCuboid(
@@ -2858,7 +2873,7 @@ static SceneNode::Ptr createBird(float size = 0.5f, const glm::vec3& color = glm
 // Helper to create school name sign
 static SceneNode::Ptr createSchoolSign(const std::string & schoolName = "TRUONG HOC")
 {
-    auto signNode = std::make_shared<SceneNode>();
+    auto signNode = MakeNode<SceneNode>();
     
     // Sign board (large rectangular board)
     float signWidth = 8.0f;
@@ -2959,7 +2974,7 @@ static SceneNode::Ptr createSchoolSign(const std::string & schoolName = "TRUONG
 // Helper to create a basketball court
 static SceneNode::Ptr createBasketballCourt(float length = 28.0f, float width = 15.0f)
 {
-    auto court = std::make_shared<SceneNode>();
+    auto court = MakeNode<SceneNode>();
     
     // Court surface (orange/brown color typical of outdoor courts)
     glm::vec3 courtColor(0.85f, 0.5f, 0.3f); // Orange-brown court
@@ -3024,8 +3039,8 @@ static SceneNode::Ptr createBasketballCourt(float length = 28.0f, float width =
         float segLength = std::sqrt((x2-x1)*(x2-x1) + (z2-z1)*(z2-z1));
         float segAngle = std::atan2(z2-z1, x2-x1);
         
-        auto segment = std::make_shared<MeshNode>(MeshType::Cube);
-        segment->material.albedo = lineColor;
+        auto segment = MakeNode<MeshNode>(MeshType::Cube);
+        segment->SetAlbedo(lineColor);
         
         glm::mat4 t(1.0f);
         t = glm::translate(t, glm::vec3((x1+x2)/2.0f, lineHeight/2.0f, (z1+z2)/2.0f));
@@ -3085,8 +3100,8 @@ static SceneNode::Ptr createBasketballCourt(float length = 28.0f, float width =
             float segLength = std::sqrt((x2-x1)*(x2-x1) + (z2-z1)*(z2-z1));
             float segAngle = std::atan2(z2-z1, x2-x1);
             
-            auto segment = std::make_shared<MeshNode>(MeshType::Cube);
-            segment->material.albedo = lineColor;
+            auto segment = MakeNode<MeshNode>(MeshType::Cube);
+            segment->SetAlbedo(lineColor);
             
             glm::mat4 t(1.0f);
             t = glm::translate(t, glm::vec3(xCenter + xOffset + (x1+x2)/2.0f, lineHeight/2.0f, (z1+z2)/2.0f));
@@ -3122,8 +3137,8 @@ static SceneNode::Ptr createBasketballCourt(float length = 28.0f, float width =
                 float segLength = std::sqrt((x2-x1)*(x2-x1) + (z2-z1)*(z2-z1));
                 float segAngle = std::atan2(z2-z1, x2-x1);
                 
-                auto segment = std::make_shared<MeshNode>(MeshType::Cube);
-                segment->material.albedo = lineColor;
+                auto segment = MakeNode<MeshNode>(MeshType::Cube);
+                segment->SetAlbedo(lineColor);
                 
                 glm::mat4 t(1.0f);
                 t = glm::translate(t, glm::vec3(xCenter + (x1+x2)/2.0f, lineHeight/2.0f, (z1+z2)/2.0f));
@@ -3205,8 +3220,8 @@ static SceneNode::Ptr createBasketballCourt(float length = 28.0f, float width =
             float segLength = std::sqrt((x2-x1)*(x2-x1) + (z2-z1)*(z2-z1));
             float segAngle = std::atan2(z2-z1, x2-x1);
             
-            auto segment = std::make_shared<MeshNode>(MeshType::Cube);
-            segment->material.albedo = rimColor;
+            auto segment = MakeNode<MeshNode>(MeshType::Cube);
+            segment->SetAlbedo(rimColor);
             
             glm::mat4 t(1.0f);
             t = glm::translate(t, glm::vec3(xPos + (side == 0 ? 0.9f : -0.9f) + (x1+x2)/2.0f, hoopHeight - 0.5f, (z1+z2)/2.0f));
@@ -3250,7 +3265,7 @@ static SceneNode::Ptr createBasketballCourt(float length = 28.0f, float width =
 // Helper to create a football (soccer) field
 static SceneNode::Ptr createFootballField(float length = 40.0f, float width = 25.0f)
 {
-    auto field = std::make_shared<SceneNode>();
+    auto field = MakeNode<SceneNode>();
     
     // Field surface (grass green)
     glm::vec3 grassColor(0.25f, 0.55f, 0.25f); // Vibrant grass green
@@ -3323,8 +3338,8 @@ static SceneNode::Ptr createFootballField(float length = 40.0f, float width = 25
         float segLength = std::sqrt((x2-x1)*(x2-x1) + (z2-z1)*(z2-z1));
         float segAngle = std::atan2(z2-z1, x2-x1);
         
-        auto segment = std::make_shared<MeshNode>(MeshType::Cube);
-        segment->material.albedo = lineColor;
+        auto segment = MakeNode<MeshNode>(MeshType::Cube);
+        segment->SetAlbedo(lineColor);
         
         glm::mat4 t(1.0f);
         t = glm::translate(t, glm::vec3((x1+x2)/2.0f, lineHeight/2.0f, (z1+z2)/2.0f));
@@ -3359,8 +3374,8 @@ static SceneNode::Ptr createFootballField(float length = 40.0f, float width = 25
                 float segLength = std::sqrt((x2-x1)*(x2-x1) + (z2-z1)*(z2-z1));
                 float segAngle = std::atan2(z2-z1, x2-x1);
                 
-                auto segment = std::make_shared<MeshNode>(MeshType::Cube);
-                segment->material.albedo = lineColor;
+                auto segment = MakeNode<MeshNode>(MeshType::Cube);
+                segment->SetAlbedo(lineColor);
                 
                 glm::mat4 t(1.0f);
                 t = glm::translate(t, glm::vec3(xCenter + (x1+x2)/2.0f, lineHeight/2.0f, (z1+z2)/2.0f));
@@ -3453,7 +3468,7 @@ static SceneNode::Ptr createFootballField(float length = 40.0f, float width = 25
 // numSteps: number of risers
 SceneNode::Ptr createStaircase(float height, float width, float depth, int numSteps)
 {
-    auto stairsNode = std::make_shared<SceneNode>();
+    auto stairsNode = MakeNode<SceneNode>();
     
     float stepHeight = height / numSteps;
     float stepDepth = depth / numSteps;
@@ -3489,8 +3504,8 @@ SceneNode::Ptr createStaircase(float height, float width, float depth, int numSt
     
     // We'll approximate stringers with rotated cuboids
     // Left Stringer
-    auto leftStringer = std::make_shared<MeshNode>(MeshType::Cube);
-    leftStringer->material.albedo = metalColor;
+    auto leftStringer = MakeNode<MeshNode>(MeshType::Cube);
+    leftStringer->SetAlbedo(metalColor);
     {
         glm::mat4 t(1.0f);
         t = glm::translate(t, glm::vec3(-width/2.0f - stringerWidth/2.0f, height/2.0f, depth/2.0f));
@@ -3501,8 +3516,8 @@ SceneNode::Ptr createStaircase(float height, float width, float depth, int numSt
     stairsNode->AddChild(leftStringer);
     
     // Right Stringer
-    auto rightStringer = std::make_shared<MeshNode>(MeshType::Cube);
-    rightStringer->material.albedo = metalColor;
+    auto rightStringer = MakeNode<MeshNode>(MeshType::Cube);
+    rightStringer->SetAlbedo(metalColor);
     {
         glm::mat4 t(1.0f);
         t = glm::translate(t, glm::vec3(width/2.0f + stringerWidth/2.0f, height/2.0f, depth/2.0f));
@@ -3517,8 +3532,8 @@ SceneNode::Ptr createStaircase(float height, float width, float depth, int numSt
     
     // Handrails (slanted parallel to stringers)
     // Left Handrail
-    auto leftHandrail = std::make_shared<MeshNode>(MeshType::Cube);
-    leftHandrail->material.albedo = woodColor; // Wooden handrail
+    auto leftHandrail = MakeNode<MeshNode>(MeshType::Cube);
+    leftHandrail->SetAlbedo(woodColor); // Wooden handrail
     {
         glm::mat4 t(1.0f);
         t = glm::translate(t, glm::vec3(-width/2.0f - stringerWidth/2.0f, height/2.0f + railHeight, depth/2.0f));
@@ -3529,8 +3544,8 @@ SceneNode::Ptr createStaircase(float height, float width, float depth, int numSt
     stairsNode->AddChild(leftHandrail);
     
     // Right Handrail
-    auto rightHandrail = std::make_shared<MeshNode>(MeshType::Cube);
-    rightHandrail->material.albedo = woodColor;
+    auto rightHandrail = MakeNode<MeshNode>(MeshType::Cube);
+    rightHandrail->SetAlbedo(woodColor);
     {
         glm::mat4 t(1.0f);
         t = glm::translate(t, glm::vec3(width/2.0f + stringerWidth/2.0f, height/2.0f + railHeight, depth/2.0f));
@@ -3570,7 +3585,7 @@ SceneNode::Ptr createStaircase(float height, float width, float depth, int numSt
 
 SceneNode::Ptr SchoolBuilder::generateSchool(float size)
 {
-    auto root = std::make_shared<SceneNode>();
+    auto root = MakeNode<SceneNode>();
     
     // -- Ground / Courtyard --
     // Sân lát gạch đá với lối đi nổi bật và các khoảng cỏ xung quanh
@@ -3579,8 +3594,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         
         // 1. Nền gạch đá chính (màu xám nhạt)
         glm::vec3 pavingColor(0.35f, 0.35f, 0.4f); // Darker concrete to avoid white-out
-        auto pavedGround = std::make_shared<MeshNode>(MeshType::Cube);
-        pavedGround->material.albedo = pavingColor;
+        auto pavedGround = MakeNode<MeshNode>(MeshType::Cube);
+        pavedGround->SetAlbedo(pavingColor);
         glm::mat4 groundT = glm::mat4(1.0f);
         groundT = glm::translate(groundT, glm::vec3(0.0f, -0.05f, 0.0f));
         groundT = glm::scale(groundT, glm::vec3(groundSize, 0.1f, groundSize));
@@ -3589,8 +3604,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         
         // 2. Lối đi chính từ cổng đến cửa (màu gạch đỏ nâu nổi bật)
         glm::vec3 pathwayColor(0.75f, 0.45f, 0.35f);  // Màu gạch đỏ nâu
-        auto pathway = std::make_shared<MeshNode>(MeshType::Cube);
-        pathway->material.albedo = pathwayColor;
+        auto pathway = MakeNode<MeshNode>(MeshType::Cube);
+        pathway->SetAlbedo(pathwayColor);
         glm::mat4 pathT = glm::mat4(1.0f);
         pathT = glm::translate(pathT, glm::vec3(0.0f, -0.03f, 10.0f));  // Từ cổng (Z=30) đến cửa (Z=-10)
         pathT = glm::scale(pathT, glm::vec3(4.0f, 0.12f, 40.0f));  // Rộng 4m, dài 40m
@@ -3601,8 +3616,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         glm::vec3 grassColor(0.3f, 0.6f, 0.3f);
         
         // Khoảng cỏ phía sau bên trái (nhỏ hơn, gần tường)
-        auto grass1 = std::make_shared<MeshNode>(MeshType::Cube);
-        grass1->material.albedo = grassColor;
+        auto grass1 = MakeNode<MeshNode>(MeshType::Cube);
+        grass1->SetAlbedo(grassColor);
         glm::mat4 g1 = glm::mat4(1.0f);
         g1 = glm::translate(g1, glm::vec3(-18.0f, -0.04f, -8.0f));
         g1 = glm::scale(g1, glm::vec3(5.0f, 0.11f, 4.0f));
@@ -3610,8 +3625,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         root->AddChild(grass1);
         
         // Khoảng cỏ phía sau bên phải (nhỏ hơn, gần tường)
-        auto grass2 = std::make_shared<MeshNode>(MeshType::Cube);
-        grass2->material.albedo = grassColor;
+        auto grass2 = MakeNode<MeshNode>(MeshType::Cube);
+        grass2->SetAlbedo(grassColor);
         glm::mat4 g2 = glm::mat4(1.0f);
         g2 = glm::translate(g2, glm::vec3(18.0f, -0.04f, -8.0f));
         g2 = glm::scale(g2, glm::vec3(5.0f, 0.11f, 4.0f));
@@ -3619,8 +3634,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         root->AddChild(grass2);
         
         // Khoảng cỏ bên trái giữa (nhỏ, trong khuôn viên)
-        auto grass3 = std::make_shared<MeshNode>(MeshType::Cube);
-        grass3->material.albedo = grassColor;
+        auto grass3 = MakeNode<MeshNode>(MeshType::Cube);
+        grass3->SetAlbedo(grassColor);
         glm::mat4 g3 = glm::mat4(1.0f);
         g3 = glm::translate(g3, glm::vec3(-20.0f, -0.04f, 3.0f));
         g3 = glm::scale(g3, glm::vec3(4.0f, 0.11f, 5.0f));
@@ -3628,8 +3643,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         root->AddChild(grass3);
         
         // Khoảng cỏ bên phải giữa (nhỏ, trong khuôn viên)
-        auto grass4 = std::make_shared<MeshNode>(MeshType::Cube);
-        grass4->material.albedo = grassColor;
+        auto grass4 = MakeNode<MeshNode>(MeshType::Cube);
+        grass4->SetAlbedo(grassColor);
         glm::mat4 g4 = glm::mat4(1.0f);
         g4 = glm::translate(g4, glm::vec3(20.0f, -0.04f, 3.0f));
         g4 = glm::scale(g4, glm::vec3(4.0f, 0.11f, 5.0f));
@@ -3637,8 +3652,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         root->AddChild(grass4);
         
         // Khoảng cỏ phía trước bên trái (nhỏ, gần cổng nhưng trong khuôn viên)
-        auto grass5 = std::make_shared<MeshNode>(MeshType::Cube);
-        grass5->material.albedo = grassColor;
+        auto grass5 = MakeNode<MeshNode>(MeshType::Cube);
+        grass5->SetAlbedo(grassColor);
         glm::mat4 g5 = glm::mat4(1.0f);
         g5 = glm::translate(g5, glm::vec3(-12.0f, -0.04f, 18.0f));
         g5 = glm::scale(g5, glm::vec3(5.0f, 0.11f, 6.0f));
@@ -3646,8 +3661,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         root->AddChild(grass5);
         
         // Khoảng cỏ phía trước bên phải (nhỏ, gần cổng nhưng trong khuôn viên)
-        auto grass6 = std::make_shared<MeshNode>(MeshType::Cube);
-        grass6->material.albedo = grassColor;
+        auto grass6 = MakeNode<MeshNode>(MeshType::Cube);
+        grass6->SetAlbedo(grassColor);
         glm::mat4 g6 = glm::mat4(1.0f);
         g6 = glm::translate(g6, glm::vec3(12.0f, -0.04f, 18.0f));
         g6 = glm::scale(g6, glm::vec3(5.0f, 0.11f, 6.0f));
@@ -3687,7 +3702,7 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
     }
 
     // School Complex Helper Node
-    auto schoolParams = std::make_shared<SceneNode>();
+    auto schoolParams = MakeNode<SceneNode>();
     schoolParams->SetLocalTransform(glm::scale(glm::mat4(1.0f), glm::vec3(size)));
     root->AddChild(schoolParams);
 
@@ -3788,16 +3803,16 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
     // -- Pathways / Courtyard Pavement --
     {
         // Path from gate to entrance
-        auto path = std::make_shared<MeshNode>(MeshType::Plane);
-        path->material.albedo = glm::vec3(0.7f, 0.7f, 0.65f); // Concrete path
+        auto path = MakeNode<MeshNode>(MeshType::Plane);
+        path->SetAlbedo(glm::vec3(0.7f, 0.7f, 0.65f)); // Concrete path
         glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.01f, 0.0f)); // Just above grass
         t = glm::scale(t, glm::vec3(4.0f, 1.0f, 20.0f)); // Wide path, long Z
         path->SetLocalTransform(t); // goes from Z=-10 to Z=10 roughly
         schoolParams->AddChild(path);
 
         // NEW: Horizontal Road near Gate (Crosses main path at Z=40 - OUTSIDE)
-        auto crossPath = std::make_shared<MeshNode>(MeshType::Plane);
-        crossPath->material.albedo = glm::vec3(0.2f, 0.2f, 0.22f); // Dark Asphalt
+        auto crossPath = MakeNode<MeshNode>(MeshType::Plane);
+        crossPath->SetAlbedo(glm::vec3(0.2f, 0.2f, 0.22f)); // Dark Asphalt
         glm::mat4 tCross = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.01f, 40.0f)); // Located at Z=40
         tCross = glm::scale(tCross, glm::vec3(100.0f, 1.0f, 10.0f)); // 100m Wide (X), 10m Deep (Z)
         crossPath->SetLocalTransform(tCross); 
@@ -3810,8 +3825,8 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         float gapLen = 1.0f;
         for (int i = 0; i < numDashes; ++i) {
             float x = -roadWidth/2.0f + i * (dashLen + gapLen) + 1.0f;
-            auto dash = std::make_shared<MeshNode>(MeshType::Plane);
-            dash->material.albedo = glm::vec3(1.0f, 1.0f, 1.0f); // White lines
+            auto dash = MakeNode<MeshNode>(MeshType::Plane);
+            dash->SetAlbedo(glm::vec3(1.0f, 1.0f, 1.0f)); // White lines
             glm::mat4 tDash = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.02f, 40.0f)); 
             tDash = glm::scale(tDash, glm::vec3(dashLen, 1.0f, 0.2f)); 
             dash->SetLocalTransform(tDash);
@@ -4143,7 +4158,7 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         // Hinge Nodes (to pivot around edges)
         
         // Left Gate Hinge
-        auto leftHinge = std::make_shared<SceneNode>();
+        auto leftHinge = MakeNode<SceneNode>();
         // Position: X = -5.0, Z = 30.0 (Fit inside arch width 12)
         leftHinge->SetLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(-5.0f, 0.0f, 30.0f)));
         
@@ -4157,7 +4172,7 @@ SceneNode::Ptr SchoolBuilder::generateSchool(float size)
         s_schoolGateLeft = leftHinge;
         
         // Right Gate Hinge
-        auto rightHinge = std::make_shared<SceneNode>();
+        auto rightHinge = MakeNode<SceneNode>();
         // Position: X = 5.0, Z = 30.0
         rightHinge->SetLocalTransform(glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 30.0f)));
         
@@ -4355,35 +4370,26 @@ void SchoolBuilder::updateBirdAnimation(SceneNode::Ptr root, float time)
         // Tangent to circle is (-z, x)
         float rotAngle = angle - 1.57f; // -90 degrees
         
-        glm::mat4 t(1.0f);
-        t = glm::translate(t, glm::vec3(x, y, z));
-        t = glm::rotate(t, rotAngle, glm::vec3(0.0f, 1.0f, 0.0f));
-        t = glm::scale(t, glm::vec3(0.5f)); // Scale down the bird
-        
-        bird->SetLocalTransform(t);
+        bird->SetLocalTRS(glm::vec3(x, y, z), glm::angleAxis(rotAngle, glm::vec3(0.0f, 1.0f, 0.0f)),
+                          glm::vec3(0.5f)); // Scale down the bird
         
         // Wing flapping
         if (bird->children.size() >= 2) {
             float flap = std::sin(time * 15.0f);
             float wingAngle = flap * 0.5f; // +/- 0.5 radians (approx 30 deg)
             
+            // Rotate about the shoulder, then push the wing out along its rotated span (pivot correction)
             // Left wing (child 1)
             auto leftWing = bird->children[1];
-            glm::mat4 lw(1.0f);
-            lw = glm::translate(lw, glm::vec3(-0.2f, 0.0f, 0.0f));
-            lw = glm::rotate(lw, wingAngle, glm::vec3(0.0f, 0.0f, 1.0f));
-            lw = glm::translate(lw, glm::vec3(-0.5f, 0.0f, 0.0f)); // Pivot correction
-            lw = glm::scale(lw, glm::vec3(1.0f, 0.1f, 0.5f));
-            leftWing->SetLocalTransform(lw);
+            const glm::quat lr = glm::angleAxis(wingAngle, glm::vec3(0.0f, 0.0f, 1.0f));
+            leftWing->SetLocalTRS(glm::vec3(-0.2f, 0.0f, 0.0f) + lr * glm::vec3(-0.5f, 0.0f, 0.0f), lr,
+                                  glm::vec3(1.0f, 0.1f, 0.5f));
             
             // Right wing (child 2)
             auto rightWing = bird->children[2];
-            glm::mat4 rw(1.0f);
-            rw = glm::translate(rw, glm::vec3(0.2f, 0.0f, 0.0f));
-            rw = glm::rotate(rw, -wingAngle, glm::vec3(0.0f, 0.0f, 1.0f));
-            rw = glm::translate(rw, glm::vec3(0.5f, 0.0f, 0.0f)); // Pivot correction
-            rw = glm::scale(rw, glm::vec3(1.0f, 0.1f, 0.5f));
-            rightWing->SetLocalTransform(rw);
+            const glm::quat rr = glm::angleAxis(-wingAngle, glm::vec3(0.0f, 0.0f, 1.0f));
+            rightWing->SetLocalTRS(glm::vec3(0.2f, 0.0f, 0.0f) + rr * glm::vec3(0.5f, 0.0f, 0.0f), rr,
+                                   glm::vec3(1.0f, 0.1f, 0.5f));
         }
     }
 }
@@ -4450,18 +4456,13 @@ void SchoolBuilder::updateGateAnimation(float deltaTime) {
             
             // So Left -> -Angle. Right -> +Angle.
             
-            // But we need to preserve position. SetLocalTransform overwrites.
-            // Reconstruct Transform: Translate + Rotate
+            // The hinges keep their position; only the rotation changes
             
             // Left Hinge at X=-5.0, Z=30.0
-            glm::mat4 leftT = glm::translate(glm::mat4(1.0f), glm::vec3(-5.0f, 0.0f, 30.0f));
-            leftT = glm::rotate(leftT, -currentGateAngle, glm::vec3(0,1,0));
-            s_schoolGateLeft->SetLocalTransform(leftT);
+            s_schoolGateLeft->SetLocalRotation(glm::angleAxis(-currentGateAngle, glm::vec3(0,1,0)));
             
             // Right Hinge at X=5.0, Z=30.0
-            glm::mat4 rightT = glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 30.0f));
-            rightT = glm::rotate(rightT, currentGateAngle, glm::vec3(0,1,0));
-            s_schoolGateRight->SetLocalTransform(rightT);
+            s_schoolGateRight->SetLocalRotation(glm::angleAxis(currentGateAngle, glm::vec3(0,1,0)));
         }
     }
     
@@ -4479,9 +4480,7 @@ void SchoolBuilder::updateGateAnimation(float deltaTime) {
                 currentLever = leverTarget;
             
             // Pivot is at (0, 0.1, 0)
-            glm::mat4 hT = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0.1f, 0));
-            hT = glm::rotate(hT, currentLever, glm::vec3(1,0,0)); // Rotate X
-            handle->SetLocalTransform(hT);
+            handle->SetLocalTRS(glm::vec3(0, 0.1f, 0), glm::angleAxis(currentLever, glm::vec3(1,0,0))); // Rotate X
         }
     }
 }
@@ -4510,38 +4509,21 @@ void SchoolBuilder::updatePeopleAnimation(SceneNode::Ptr root, float time)
         
         // Animate arms (swing forward/back around X axis)
         if (leftArm) {
-            glm::mat4 t = leftArm->GetLocalTransform();
-            // Extract translation
-            glm::vec3 pos = glm::vec3(t[3]);
-            // Apply rotation around shoulder
-            t = glm::translate(glm::mat4(1.0f), pos);
-            t = glm::rotate(t, glm::radians(armSwing), glm::vec3(1.0f, 0.0f, 0.0f));
-            leftArm->SetLocalTransform(t);
+            // Rotate around the shoulder; the pivot keeps its position
+            leftArm->SetLocalRotation(glm::angleAxis(glm::radians(armSwing), glm::vec3(1.0f, 0.0f, 0.0f)));
         }
         
         if (rightArm) {
-            glm::mat4 t = rightArm->GetLocalTransform();
-            glm::vec3 pos = glm::vec3(t[3]);
-            t = glm::translate(glm::mat4(1.0f), pos);
-            t = glm::rotate(t, glm::radians(-armSwing), glm::vec3(1.0f, 0.0f, 0.0f));
-            rightArm->SetLocalTransform(t);
+            rightArm->SetLocalRotation(glm::angleAxis(glm::radians(-armSwing), glm::vec3(1.0f, 0.0f, 0.0f)));
         }
         
         // Animate legs (swing forward/back around X axis)
         if (leftLeg) {
-            glm::mat4 t = leftLeg->GetLocalTransform();
-            glm::vec3 pos = glm::vec3(t[3]);
-            t = glm::translate(glm::mat4(1.0f), pos);
-            t = glm::rotate(t, glm::radians(-legSwing), glm::vec3(1.0f, 0.0f, 0.0f));
-            leftLeg->SetLocalTransform(t);
+            leftLeg->SetLocalRotation(glm::angleAxis(glm::radians(-legSwing), glm::vec3(1.0f, 0.0f, 0.0f)));
         }
         
         if (rightLeg) {
-            glm::mat4 t = rightLeg->GetLocalTransform();
-            glm::vec3 pos = glm::vec3(t[3]);
-            t = glm::translate(glm::mat4(1.0f), pos);
-            t = glm::rotate(t, glm::radians(legSwing), glm::vec3(1.0f, 0.0f, 0.0f));
-            rightLeg->SetLocalTransform(t);
+            rightLeg->SetLocalRotation(glm::angleAxis(glm::radians(legSwing), glm::vec3(1.0f, 0.0f, 0.0f)));
         }
     };
     
@@ -4553,9 +4535,7 @@ void SchoolBuilder::updatePeopleAnimation(SceneNode::Ptr root, float time)
         bool movingForward = (std::sin(time * walkSpeed) > 0);
         float angle = movingForward ? 45.0f : -135.0f;
         float direction = movingForward ? 1.0f : -1.0f;
-        glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, 10.0f));
-        t = glm::rotate(t, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-        s_people[0]->SetLocalTransform(t);
+        s_people[0]->SetLocalTRS(glm::vec3(x, 0.0f, 10.0f), glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f)));
         animateLimbs(s_people[0], time * walkSpeed, direction);
     }
     
@@ -4567,9 +4547,7 @@ void SchoolBuilder::updatePeopleAnimation(SceneNode::Ptr root, float time)
         bool movingForward = (std::sin(time * walkSpeed) > 0);
         float angle = movingForward ? 0.0f : 180.0f;
         float direction = movingForward ? 1.0f : -1.0f;
-        glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(6.0f, 0.0f, z));
-        t = glm::rotate(t, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-        s_people[1]->SetLocalTransform(t);
+        s_people[1]->SetLocalTRS(glm::vec3(6.0f, 0.0f, z), glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f)));
         animateLimbs(s_people[1], time * walkSpeed, direction);
     }
     
@@ -4581,9 +4559,7 @@ void SchoolBuilder::updatePeopleAnimation(SceneNode::Ptr root, float time)
         float x = -20.0f + std::cos(time * walkSpeed) * radius;
         float z = -10.0f + std::sin(time * walkSpeed) * radius;
         float angle = time * walkSpeed * 180.0f / 3.14159f + 90.0f;
-        glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, z));
-        t = glm::rotate(t, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-        s_people[2]->SetLocalTransform(t);
+        s_people[2]->SetLocalTRS(glm::vec3(x, 0.0f, z), glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f)));
         animateLimbs(s_people[2], time * walkSpeed, 1.0f); // Always forward for circular
     }
     
@@ -4595,9 +4571,7 @@ void SchoolBuilder::updatePeopleAnimation(SceneNode::Ptr root, float time)
         bool movingForward = (std::sin(time * walkSpeed) > 0);
         float angle = movingForward ? 0.0f : 180.0f;
         float direction = movingForward ? 1.0f : -1.0f;
-        glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(22.0f, 0.0f, z));
-        t = glm::rotate(t, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-        s_people[3]->SetLocalTransform(t);
+        s_people[3]->SetLocalTRS(glm::vec3(22.0f, 0.0f, z), glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f)));
         animateLimbs(s_people[3], time * walkSpeed, direction);
     }
     
@@ -4611,9 +4585,7 @@ void SchoolBuilder::updatePeopleAnimation(SceneNode::Ptr root, float time)
         bool movingForward = (std::sin(time * walkSpeed) > 0);
         float angle = movingForward ? 90.0f : -90.0f;
         float direction = movingForward ? 1.0f : -1.0f;
-        glm::mat4 t = glm::translate(glm::mat4(1.0f), glm::vec3(x, 0.0f, 20.0f));
-        t = glm::rotate(t, glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f));
-        s_people[5]->SetLocalTransform(t);
+        s_people[5]->SetLocalTRS(glm::vec3(x, 0.0f, 20.0f), glm::angleAxis(glm::radians(angle), glm::vec3(0.0f, 1.0f, 0.0f)));
         animateLimbs(s_people[5], time * walkSpeed, direction);
     }
 }
@@ -4639,20 +4611,12 @@ void SchoolBuilder::updateClockAnimation(SceneNode::Ptr root, float time)
     
     // Update hour hand
     if (hourHand) {
-        glm::mat4 t = hourHand->GetLocalTransform();
-        glm::vec3 pos = glm::vec3(t[3]);
-        t = glm::translate(glm::mat4(1.0f), pos);
-        t = glm::rotate(t, glm::radians(-hoursAngle), glm::vec3(0.0f, 0.0f, 1.0f)); // Rotate around Z axis
-        hourHand->SetLocalTransform(t);
+        hourHand->SetLocalRotation(glm::angleAxis(glm::radians(-hoursAngle), glm::vec3(0.0f, 0.0f, 1.0f))); // Rotate around Z axis
     }
     
     // Update minute hand
     if (minuteHand) {
-        glm::mat4 t = minuteHand->GetLocalTransform();
-        glm::vec3 pos = glm::vec3(t[3]);
-        t = glm::translate(glm::mat4(1.0f), pos);
-        t = glm::rotate(t, glm::radians(-minutesAngle), glm::vec3(0.0f, 0.0f, 1.0f));
-        minuteHand->SetLocalTransform(t);
+        minuteHand->SetLocalRotation(glm::angleAxis(glm::radians(-minutesAngle), glm::vec3(0.0f, 0.0f, 1.0f)));
     }
 }
 
@@ -4670,9 +4634,8 @@ void SchoolBuilder::updateCloudAnimation(SceneNode::Ptr root, float time)
     
     for (size_t i = 0; i < s_clouds.size() && i < 12; ++i)
     {
-        // Get current transform
-        glm::mat4 t = s_clouds[i]->GetLocalTransform();
-        glm::vec3 pos = glm::vec3(t[3]);
+        // Get current position
+        glm::vec3 pos = s_clouds[i]->GetLocalTRS().position;
         
         // Calculate new X position (drift from left to right)
         float offset = std::sin(time * cloudSpeeds[i] * 0.1f) * cloudRange;
@@ -4680,9 +4643,7 @@ void SchoolBuilder::updateCloudAnimation(SceneNode::Ptr root, float time)
         // Update position (keep original Y and Z, only change X)
         pos.x = basePositions[i] + offset;
         
-        // Set new transform
-        t = glm::translate(glm::mat4(1.0f), pos);
-        s_clouds[i]->SetLocalTransform(t);
+        s_clouds[i]->SetLocalPosition(pos);
     }
 }
 
@@ -4704,15 +4665,14 @@ void SchoolBuilder::updateCarAnimation(float dt)
         }
         
         // Update Transform
-        glm::mat4 t = glm::mat4(1.0f);
         // Base position on the road
         float roadZ = (car.direction == 1) ? 37.5f : 42.5f;
         
-        t = glm::translate(t, glm::vec3(car.currentX, 0.0f, roadZ));
+        glm::quat heading(1.0f, 0.0f, 0.0f, 0.0f);
         if (car.direction == -1) {
-            t = glm::rotate(t, glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            heading = glm::angleAxis(glm::radians(180.0f), glm::vec3(0.0f, 1.0f, 0.0f));
         }
-        car.node->SetLocalTransform(t);
+        car.node->SetLocalTRS(glm::vec3(car.currentX, 0.0f, roadZ), heading);
         
         // --- Animate Wheels (Spinning) ---
         // Wheels are children indices 3, 4, 5, 6
@@ -4760,20 +4720,10 @@ void SchoolBuilder::updateCarAnimation(float dt)
              for (int i = 0; i < 4; ++i) {
                  auto wheel = car.node->children[3 + i];
                  
-                 // Reconstruct Wheel Transform
-                 glm::mat4 wt(1.0f);
-                 wt = glm::translate(wt, glm::vec3(wheelX[i], 0.4f, wheelZ[i])); // Position
-                 
-                 // Rotate around Z axis for Spin
-                 wt = glm::rotate(wt, spinAngle, glm::vec3(0, 0, 1));
-                 
-                 // Original Orientation: Rotate 90 deg around X axis
-                 wt = glm::rotate(wt, glm::radians(90.0f), glm::vec3(1, 0, 0));
-                 
-                 // Scale
-                 wt = glm::scale(wt, glm::vec3(0.8f, 0.4f, 0.8f));
-                 
-                 wheel->SetLocalTransform(wt);
+                 // Spin around Z after the original orientation (90 deg around X)
+                 const glm::quat spin = glm::angleAxis(spinAngle, glm::vec3(0, 0, 1)) *
+                                        glm::angleAxis(glm::radians(90.0f), glm::vec3(1, 0, 0));
+                 wheel->SetLocalTRS(glm::vec3(wheelX[i], 0.4f, wheelZ[i]), spin, glm::vec3(0.8f, 0.4f, 0.8f));
              }
         }
     }
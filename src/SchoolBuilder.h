@@ -1,5 +1,6 @@
 #pragma once
 
+#include "MeshNode.h"
 #include "SceneNode.h"
 #include <vector>
 
@@ -7,50 +8,13 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <memory>
 
-// Small helper types used by SchoolBuilder
-struct Material
-{
-    glm::vec3 albedo = glm::vec3(1.0f);
-};
-
-enum class MeshType
-{
-    Cube,
-    Plane,
-    Pyramid,
-    Cylinder,
-    Cone,
-    Sphere
-};
-
-// A SceneNode subclass that carries a mesh type + basic material information.
-// Rendering code can cast SceneNode pointers to MeshNode to access mesh/material.
-class MeshNode : public SceneNode
-{
-public:
-    using Ptr = std::shared_ptr<MeshNode>;
-
-    MeshNode(MeshType type = MeshType::Cube)
-        : SceneNode(), mesh(type)
-    {
-    }
-
-    MeshNode(const glm::mat4& local, MeshType type = MeshType::Cube)
-        : SceneNode(local), mesh(type)
-    {
-    }
-
-    MeshType mesh;
-    Material material;
-};
-
 // Build a high-quality architectural school composed of various primitives.
-// Returns the root SceneNode (shared_ptr) that owns the entire structure.
+// Returns the root SceneNode, which owns the entire structure (nodes live in the SceneArena).
 class SchoolBuilder
 {
 public:
     // Generates the scene root of a U-shaped school. size scales the overall footprint.
-    // The returned node is a SceneNode::Ptr (shared ownership).
+    // The returned node is a SceneNode::Ptr (counted handle).
     static SceneNode::Ptr generateSchool(float size = 1.0f);
     
     // Update people animations (call this every frame with current time)
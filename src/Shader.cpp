@@ -8,11 +8,11 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
-Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
+Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath, const std::string& defines)
 {
     // 1. Retrieve shader source code from files
-    const std::string vertexCode = ReadFile(vertexPath);
-    const std::string fragmentCode = ReadFile(fragmentPath);
+    const std::string vertexCode = InjectDefines(ReadFile(vertexPath), defines);
+    const std::string fragmentCode = InjectDefines(ReadFile(fragmentPath), defines);
     const char* vShaderCode = vertexCode.c_str();
     const char* fShaderCode = fragmentCode.c_str();
 
@@ -40,10 +40,36 @@ Shader::Shader(const std::string& vertexPath, const std::string& fragmentPath)
     // 4. Cleanup shader objects (no longer needed after linking)
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+
+    // 5. Cache every active uniform location
+    ReflectUniforms();
+}
+
+Shader Shader::FromCompute(const std::string& computePath, const std::string& defines)
+{
+    const std::string computeCode = InjectDefines(ReadFile(computePath), defines);
+    const char* cShaderCode = computeCode.c_str();
+
+    GLuint compute = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(compute, 1, &cShaderCode, nullptr);
+    glCompileShader(compute);
+    CheckCompileErrors(compute, "COMPUTE");
+
+    Shader shader;
+    shader.ID = glCreateProgram();
+    glAttachShader(shader.ID, compute);
+    glLinkProgram(shader.ID);
+    CheckCompileErrors(shader.ID, "PROGRAM");
+
+    glDeleteShader(compute);
+
+    shader.ReflectUniforms();
+    return shader;
 }
 
 Shader::Shader(Shader&& other) noexcept
-    : ID(other.ID)
+    : ID(other.ID),
+      uniformLocations(std::move(other.uniformLocations))
 {
     other.ID = 0;
 }
@@ -54,6 +80,7 @@ Shader& Shader::operator=(Shader&& other) noexcept
     {
         if (ID != 0) glDeleteProgram(ID);
         ID = other.ID;
+        uniformLocations = std::move(other.uniformLocations);
         other.ID = 0;
     }
     return *this;
@@ -70,39 +97,146 @@ void Shader::Use() const
     glUseProgram(ID);
 }
 
-void Shader::SetBool(const std::string& name, bool value) const
+void Shader::Dispatch(GLuint groupsX, GLuint groupsY, GLuint groupsZ) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), static_cast<int>(value));
+    glUseProgram(ID);
+    glDispatchCompute(groupsX, groupsY, groupsZ);
 }
 
-void Shader::SetInt(const std::string& name, int value) const
+void Shader::ReflectUniforms()
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    uniformLocations.clear();
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    if (count <= 0 || maxLength <= 0) return;
+
+    std::string buffer(static_cast<size_t>(maxLength), '\0');
+    for (GLint i = 0; i < count; ++i)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(ID, static_cast<GLuint>(i), maxLength, &length, &size, &type, &buffer[0]);
+
+        std::string name(buffer.data(), static_cast<size_t>(length));
+        const GLint location = glGetUniformLocation(ID, name.c_str());
+        if (location < 0) continue; // member of a uniform block
+
+        uniformLocations[name] = location;
+
+        // Arrays of basic types are reported once as "name[0]" with size > 1:
+        // register the bare name and every element so "name[i]" lookups work too.
+        const std::string_view suffix = "[0]";
+        if (name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            const std::string base = name.substr(0, name.size() - suffix.size());
+            uniformLocations[base] = location;
+            for (GLint e = 1; e < size; ++e)
+            {
+                const std::string element = base + "[" + std::to_string(e) + "]";
+                uniformLocations[element] = glGetUniformLocation(ID, element.c_str());
+            }
+        }
+    }
+}
+
+GLint Shader::GetUniformLocation(std::string_view name) const
+{
+    auto it = uniformLocations.find(name);
+    return it != uniformLocations.end() ? it->second : -1;
+}
+
+bool Shader::BindUniformBlock(std::string_view blockName, GLuint bindingPoint) const
+{
+    const std::string name(blockName);
+    const GLuint index = glGetUniformBlockIndex(ID, name.c_str());
+    if (index == GL_INVALID_INDEX) return false;
+
+    glUniformBlockBinding(ID, index, bindingPoint);
+    return true;
 }
 
-void Shader::SetFloat(const std::string& name, float value) const
+void Shader::SetBool(std::string_view name, bool value) const
 {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    glUniform1i(GetUniformLocation(name), static_cast<int>(value));
 }
 
-void Shader::SetVec3(const std::string& name, const glm::vec3& value) const
+void Shader::SetInt(std::string_view name, int value) const
 {
-    glUniform3fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(value));
+    glUniform1i(GetUniformLocation(name), value);
 }
 
-void Shader::SetVec3(const std::string& name, float x, float y, float z) const
+void Shader::SetFloat(std::string_view name, float value) const
 {
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+    glUniform1f(GetUniformLocation(name), value);
 }
 
-void Shader::SetVec4(const std::string& name, const glm::vec4& value) const
+void Shader::SetVec2(std::string_view name, const glm::vec2& value) const
 {
-    glUniform4fv(glGetUniformLocation(ID, name.c_str()), 1, glm::value_ptr(value));
+    glUniform2f(GetUniformLocation(name), value.x, value.y);
 }
 
-void Shader::SetMat4(const std::string& name, const glm::mat4& mat) const
+void Shader::SetVec3(std::string_view name, const glm::vec3& value) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(mat));
+    glUniform3fv(GetUniformLocation(name), 1, glm::value_ptr(value));
+}
+
+void Shader::SetVec3(std::string_view name, float x, float y, float z) const
+{
+    glUniform3f(GetUniformLocation(name), x, y, z);
+}
+
+void Shader::SetVec4(std::string_view name, const glm::vec4& value) const
+{
+    glUniform4fv(GetUniformLocation(name), 1, glm::value_ptr(value));
+}
+
+void Shader::SetMat4(std::string_view name, const glm::mat4& mat) const
+{
+    glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+void Shader::Set(Uniform<bool> uniform, bool value) const
+{
+    glUniform1i(uniform.location, static_cast<int>(value));
+}
+
+void Shader::Set(Uniform<int> uniform, int value) const
+{
+    glUniform1i(uniform.location, value);
+}
+
+void Shader::Set(Uniform<unsigned int> uniform, unsigned int value) const
+{
+    glUniform1ui(uniform.location, value);
+}
+
+void Shader::Set(Uniform<float> uniform, float value) const
+{
+    glUniform1f(uniform.location, value);
+}
+
+void Shader::Set(Uniform<glm::vec2> uniform, const glm::vec2& value) const
+{
+    glUniform2f(uniform.location, value.x, value.y);
+}
+
+void Shader::Set(Uniform<glm::vec3> uniform, const glm::vec3& value) const
+{
+    glUniform3fv(uniform.location, 1, glm::value_ptr(value));
+}
+
+void Shader::Set(Uniform<glm::vec4> uniform, const glm::vec4& value) const
+{
+    glUniform4fv(uniform.location, 1, glm::value_ptr(value));
+}
+
+void Shader::Set(Uniform<glm::mat4> uniform, const glm::mat4& value) const
+{
+    glUniformMatrix4fv(uniform.location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
 std::string Shader::ReadFile(const std::string& path)
@@ -118,10 +252,30 @@ std::string Shader::ReadFile(const std::string& path)
     return contents.str();
 }
 
+std::string Shader::InjectDefines(const std::string& source, const std::string& defines)
+{
+    if (defines.empty()) return source;
+
+    // #version must stay the first directive, so the defines go on the line after it
+    size_t insertAt = 0;
+    const size_t versionPos = source.find("#version");
+    if (versionPos != std::string::npos)
+    {
+        const size_t lineEnd = source.find('\n', versionPos);
+        insertAt = (lineEnd == std::string::npos) ? source.size() : lineEnd + 1;
+    }
+
+    std::string result = source;
+    std::string block = defines;
+    if (block.back() != '\n') block += '\n';
+    result.insert(insertAt, block);
+    return result;
+}
+
 void Shader::CheckCompileErrors(GLuint object, const std::string& type)
 {
     GLint success = 0;
-    if (type == "VERTEX" || type == "FRAGMENT")
+    if (type == "VERTEX" || type == "FRAGMENT" || type == "COMPUTE")
     {
         glGetShaderiv(object, GL_COMPILE_STATUS, &success);
         if (!success)
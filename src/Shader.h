@@ -2,13 +2,28 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <functional>
 #include <glm/glm.hpp>
 #include <glad/glad.h>
 
+// Pre-resolved uniform location. T is the C++ type matching the GLSL uniform,
+// so a handle can only be passed to the matching Shader::Set overload.
+template <typename T>
+struct Uniform
+{
+    GLint location = -1;
+
+    bool IsValid() const { return location >= 0; }
+};
+
 // Simple OpenGL shader helper:
-// - Loads vertex/fragment GLSL from files
+// - Loads vertex/fragment (or compute) GLSL from files
 // - Compiles, links and exposes a program ID
-// - Utility setters for common uniform types (bool, int, float, vec3, mat4)
+// - Reflects all active uniforms once at link time (name -> location hash table)
+// - Utility setters for common uniform types (bool, int, float, vec3, mat4),
+//   either by name (hash lookup, no GL query) or through pre-resolved Uniform<T> handles
 class Shader
 {
 public:
@@ -16,7 +31,11 @@ public:
     unsigned int ID = 0;
 
     // Construct from file paths (vertex + fragment). Throws std::runtime_error on file IO errors.
-    Shader(const std::string& vertexPath, const std::string& fragmentPath);
+    // defines (e.g. "#define MAX_POINT_LIGHTS 512\n") are inserted right after each #version line.
+    Shader(const std::string& vertexPath, const std::string& fragmentPath, const std::string& defines = "");
+
+    // Compute program from a single file (needs a GL 4.3 context or ARB_compute_shader).
+    static Shader FromCompute(const std::string& computePath, const std::string& defines = "");
 
     // Non-copyable (shader programs should be unique). Movable for convenience.
     Shader(const Shader&) = delete;
@@ -29,16 +48,57 @@ public:
     // Activate the shader
     void Use() const;
 
-    // Uniform helpers
-    void SetBool(const std::string& name, bool value) const;
-    void SetInt(const std::string& name, int value) const;
-    void SetFloat(const std::string& name, float value) const;
-    void SetVec3(const std::string& name, const glm::vec3& value) const;
-    void SetVec3(const std::string& name, float x, float y, float z) const;
-    void SetVec4(const std::string& name, const glm::vec4& value) const;
-    void SetMat4(const std::string& name, const glm::mat4& mat) const;
+    // Use() + glDispatchCompute for compute programs
+    void Dispatch(GLuint groupsX, GLuint groupsY = 1, GLuint groupsZ = 1) const;
+
+    // Location of an active uniform reflected at link time, or -1 if the name is unknown
+    // (inactive uniforms are optimized out by the driver and are also reported as -1).
+    GLint GetUniformLocation(std::string_view name) const;
+
+    // Resolve a typed handle once (e.g. at startup) and reuse it every frame.
+    template <typename T>
+    Uniform<T> GetUniform(std::string_view name) const { return Uniform<T>{ GetUniformLocation(name) }; }
+
+    // Assign a uniform block to a buffer binding point (GLSL 330 has no layout(binding) for blocks).
+    // Returns false if the block is not active in this program.
+    bool BindUniformBlock(std::string_view blockName, GLuint bindingPoint) const;
+
+    // Uniform helpers (by name)
+    void SetBool(std::string_view name, bool value) const;
+    void SetInt(std::string_view name, int value) const;
+    void SetFloat(std::string_view name, float value) const;
+    void SetVec2(std::string_view name, const glm::vec2& value) const;
+    void SetVec3(std::string_view name, const glm::vec3& value) const;
+    void SetVec3(std::string_view name, float x, float y, float z) const;
+    void SetVec4(std::string_view name, const glm::vec4& value) const;
+    void SetMat4(std::string_view name, const glm::mat4& mat) const;
+
+    // Uniform helpers (by pre-resolved handle)
+    void Set(Uniform<bool> uniform, bool value) const;
+    void Set(Uniform<int> uniform, int value) const;
+    void Set(Uniform<unsigned int> uniform, unsigned int value) const;
+    void Set(Uniform<float> uniform, float value) const;
+    void Set(Uniform<glm::vec2> uniform, const glm::vec2& value) const;
+    void Set(Uniform<glm::vec3> uniform, const glm::vec3& value) const;
+    void Set(Uniform<glm::vec4> uniform, const glm::vec4& value) const;
+    void Set(Uniform<glm::mat4> uniform, const glm::mat4& value) const;
 
 private:
+    Shader() = default;
+
+    // Heterogeneous lookup so string_view / literals don't allocate a std::string
+    struct StringHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view s) const { return std::hash<std::string_view>{}(s); }
+    };
+
+    std::unordered_map<std::string, GLint, StringHash, std::equal_to<>> uniformLocations;
+
+    // Fills uniformLocations from the linked program (all array elements included).
+    void ReflectUniforms();
+
     static std::string ReadFile(const std::string& path);
+    static std::string InjectDefines(const std::string& source, const std::string& defines);
     static void CheckCompileErrors(GLuint object, const std::string& type);
 };
\ No newline at end of file
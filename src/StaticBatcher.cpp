@@ -0,0 +1,215 @@
+#include "StaticBatcher.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+#include "GLUtils.h"
+
+namespace
+{
+    constexpr size_t kMeshTypeCount = static_cast<size_t>(MeshType::Sphere) + 1;
+
+    MeshData BuildMesh(MeshType type)
+    {
+        switch (type)
+        {
+        case MeshType::Cube: return buildCubeMesh();
+        case MeshType::Plane: return buildPlaneMesh();
+        case MeshType::Pyramid: return buildPyramidMesh();
+        case MeshType::Cylinder: return buildCylinderMesh();
+        case MeshType::Cone: return buildConeMesh();
+        case MeshType::Sphere: return buildSphereMesh();
+        }
+        return MeshData{};
+    }
+
+    // Orders albedos bitwise so identical colors end up adjacent
+    bool AlbedoLess(const glm::vec3& a, const glm::vec3& b)
+    {
+        return std::memcmp(&a, &b, sizeof(glm::vec3)) < 0;
+    }
+
+    // XZ cell of the mesh's world bounds center, packed into one sortable key
+    uint64_t CellKey(const MeshNode* mesh, float cellSize)
+    {
+        AABB local;
+        if (!mesh->GetLocalBounds(local)) return 0;
+        const AABB world = TransformAABB(local, mesh->GetGlobalAffine());
+        const glm::vec3 center = (world.min + world.max) * 0.5f;
+        const int64_t x = static_cast<int64_t>(std::floor(center.x / cellSize)) + (1 << 30);
+        const int64_t z = static_cast<int64_t>(std::floor(center.z / cellSize)) + (1 << 30);
+        return (static_cast<uint64_t>(z) << 32) | static_cast<uint64_t>(x);
+    }
+}
+
+StaticBatcher::~StaticBatcher()
+{
+    Clear();
+}
+
+void StaticBatcher::Clear()
+{
+    if (ebo != 0) glDeleteBuffers(1, &ebo);
+    if (vbo != 0) glDeleteBuffers(1, &vbo);
+    if (vao != 0) glDeleteVertexArrays(1, &vao);
+    ebo = 0;
+    vbo = 0;
+    vao = 0;
+
+    buckets.clear();
+    dynamicRoots.clear();
+    staticMeshCount = 0;
+    dynamicMeshCount = 0;
+    vertexCount = 0;
+    indexCount = 0;
+}
+
+void StaticBatcher::Collect(const SceneNode::Ptr& node, bool dynamic,
+                            const std::unordered_set<const SceneNode*>& dynamicSet, std::vector<const MeshNode*>& out)
+{
+    if (!node) return;
+
+    if (!dynamic && dynamicSet.count(node.get()) > 0)
+    {
+        dynamic = true;
+        dynamicRoots.push_back(node);
+    }
+
+    if (const MeshNode* meshNode = NodeCast<MeshNode>(node.get()))
+    {
+        if (dynamic) ++dynamicMeshCount;
+        else out.push_back(meshNode);
+    }
+
+    for (auto& c : node->children)
+        Collect(c, dynamic, dynamicSet, out);
+}
+
+void StaticBatcher::Bake(const SceneNode::Ptr& root, const std::vector<SceneNode::Ptr>& dynamicRootList)
+{
+    Clear();
+
+    std::unordered_set<const SceneNode*> dynamicSet;
+    for (const auto& node : dynamicRootList)
+        dynamicSet.insert(node.get());
+
+    std::vector<const MeshNode*> meshes;
+    Collect(root, false, dynamicSet, meshes);
+    staticMeshCount = meshes.size();
+    if (meshes.empty()) return;
+
+    // Group by cell, then albedo; stable so each bucket keeps the scene's traversal order
+    std::vector<std::pair<uint64_t, const MeshNode*>> keyed;
+    keyed.reserve(meshes.size());
+    for (const MeshNode* mesh : meshes)
+        keyed.emplace_back(CellKey(mesh, kCellSize), mesh);
+    std::stable_sort(keyed.begin(), keyed.end(), [](const auto& a, const auto& b) {
+        if (a.first != b.first) return a.first < b.first;
+        return AlbedoLess(a.second->GetMaterial().albedo, b.second->GetMaterial().albedo);
+    });
+
+    std::array<MeshData, kMeshTypeCount> sources;
+    for (size_t t = 0; t < kMeshTypeCount; ++t)
+        sources[t] = BuildMesh(static_cast<MeshType>(t));
+
+    size_t totalVertices = 0;
+    size_t totalIndices = 0;
+    for (const MeshNode* mesh : meshes)
+    {
+        totalVertices += sources[static_cast<size_t>(mesh->GetMeshType())].GetVertexCount();
+        totalIndices += sources[static_cast<size_t>(mesh->GetMeshType())].GetIndexCount();
+    }
+
+    std::vector<float> vertices;
+    vertices.reserve(totalVertices * kFloatsPerVertex);
+    std::vector<uint32_t> indices;
+    indices.reserve(totalIndices);
+
+    for (const auto& [cell, mesh] : keyed)
+    {
+        if (buckets.empty() || buckets.back().cell != cell ||
+            std::memcmp(&buckets.back().albedo, &mesh->GetMaterial().albedo, sizeof(glm::vec3)) != 0)
+        {
+            Bucket bucket;
+            bucket.cell = cell;
+            bucket.albedo = mesh->GetMaterial().albedo;
+            bucket.bounds = EmptyAABB();
+            bucket.firstIndex = indices.size();
+            buckets.push_back(bucket);
+        }
+
+        const glm::mat4 model = mesh->GetGlobalTransform();
+        const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(model)));
+
+        const MeshData& source = sources[static_cast<size_t>(mesh->GetMeshType())];
+        const uint32_t baseVertex = static_cast<uint32_t>(vertices.size() / kFloatsPerVertex);
+        for (size_t v = 0; v < source.vertices.size(); v += kFloatsPerVertex)
+        {
+            const float* in = &source.vertices[v];
+            const glm::vec3 p = glm::vec3(model * glm::vec4(in[0], in[1], in[2], 1.0f));
+            glm::vec3 n = normalMatrix * glm::vec3(in[3], in[4], in[5]);
+            const float len = glm::length(n);
+            if (len > 0.0f) n /= len;
+
+            vertices.insert(vertices.end(), { p.x, p.y, p.z, n.x, n.y, n.z, in[6], in[7] });
+            buckets.back().bounds.min = glm::min(buckets.back().bounds.min, p);
+            buckets.back().bounds.max = glm::max(buckets.back().bounds.max, p);
+        }
+
+        // The source order is already cache-optimized; only rebase it
+        for (uint32_t index : source.indices)
+            indices.push_back(baseVertex + index);
+
+        buckets.back().indexCount += static_cast<GLsizei>(source.GetIndexCount());
+    }
+
+    vertexCount = vertices.size() / kFloatsPerVertex;
+    indexCount = indices.size();
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), GL_STATIC_DRAW);
+
+    constexpr GLsizei stride = static_cast<GLsizei>(kFloatsPerVertex * sizeof(float));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(0));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(3 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, reinterpret_cast<void*>(6 * sizeof(float)));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+size_t StaticBatcher::Draw(const Shader& shader, Uniform<glm::mat4> modelUniform, Uniform<glm::vec3> albedoUniform,
+                          const Frustum* frustum, const OcclusionCuller* occlusion) const
+{
+    if (vao == 0) return 0;
+
+    shader.Set(modelUniform, glm::mat4(1.0f));
+
+    size_t draws = 0;
+    glBindVertexArray(vao);
+    for (const Bucket& bucket : buckets)
+    {
+        if (frustum && frustum->Classify(bucket.bounds) == Frustum::Result::Outside) continue;
+        if (occlusion && occlusion->IsOccluded(bucket.bounds)) continue;
+
+        shader.Set(albedoUniform, bucket.albedo);
+        glDrawElements(GL_TRIANGLES, bucket.indexCount, GL_UNSIGNED_INT,
+                       reinterpret_cast<void*>(bucket.firstIndex * sizeof(uint32_t)));
+        ++draws;
+    }
+    glBindVertexArray(0);
+    return draws;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "Collision.h"
+#include "Frustum.h"
+#include "OcclusionCuller.h"
+#include "SceneNode.h"
+#include "SchoolBuilder.h"
+#include "Shader.h"
+
+// Bakes the frozen part of a scene into merged geometry.
+// Every MeshNode that is not below one of the given animated roots (people, doors, gates, cars,
+// flag, clock, ...) is pre-transformed into world space (positions by the global transform,
+// normals by its inverse transpose) and appended to one shared vertex/index buffer, grouped into
+// one contiguous index range per (kCellSize XZ cell, albedo) so every bucket has compact bounds
+// for culling. Draw() then issues a single glDrawElements per visible bucket;
+// the animated subtrees keep going through the regular per-node / instanced path.
+// Bake again if the static part of the scene is edited.
+class StaticBatcher
+{
+public:
+    StaticBatcher() = default;
+    ~StaticBatcher();
+
+    StaticBatcher(const StaticBatcher&) = delete;
+    StaticBatcher& operator=(const StaticBatcher&) = delete;
+
+    // Global transforms below root must be up to date.
+    void Bake(const SceneNode::Ptr& root, const std::vector<SceneNode::Ptr>& dynamicRoots);
+
+    // Releases the merged buffers.
+    void Clear();
+
+    // One draw per bucket with model = identity, skipping buckets whose bounds are outside frustum
+    // or hidden in the occlusion buffer (each if given; occlusion must have been rendered this frame).
+    // The shader must already be in use with useInstancing disabled.
+    // Returns the number of draw calls issued.
+    size_t Draw(const Shader& shader, Uniform<glm::mat4> modelUniform, Uniform<glm::vec3> albedoUniform,
+                const Frustum* frustum = nullptr, const OcclusionCuller* occlusion = nullptr) const;
+
+    bool IsBaked() const { return vao != 0; }
+
+    // Outermost animated roots reachable from the baked root (nested ones are left out so
+    // rendering each of them draws every dynamic mesh exactly once).
+    const std::vector<SceneNode::Ptr>& GetDynamicRoots() const { return dynamicRoots; }
+
+    // Stats of the last Bake()
+    size_t GetStaticMeshCount() const { return staticMeshCount; }
+    size_t GetDynamicMeshCount() const { return dynamicMeshCount; }
+    size_t GetBucketCount() const { return buckets.size(); }
+    size_t GetVertexCount() const { return vertexCount; }
+    size_t GetIndexCount() const { return indexCount; }
+    size_t GetBufferBytes() const { return vertexCount * kFloatsPerVertex * sizeof(float) + indexCount * sizeof(uint32_t); }
+
+private:
+    static constexpr size_t kFloatsPerVertex = 8;
+    static constexpr float kCellSize = 24.0f; // XZ edge of a bucket cell in world units
+
+    struct Bucket
+    {
+        uint64_t cell = 0;
+        glm::vec3 albedo;
+        AABB bounds;
+        size_t firstIndex = 0;
+        GLsizei indexCount = 0;
+    };
+
+    void Collect(const SceneNode::Ptr& node, bool dynamic,
+                 const std::unordered_set<const SceneNode*>& dynamicSet, std::vector<const MeshNode*>& out);
+
+    GLuint vao = 0;
+    GLuint vbo = 0;
+    GLuint ebo = 0;
+    std::vector<Bucket> buckets;
+    std::vector<SceneNode::Ptr> dynamicRoots;
+
+    size_t staticMeshCount = 0;
+    size_t dynamicMeshCount = 0;
+    size_t vertexCount = 0;
+    size_t indexCount = 0;
+};
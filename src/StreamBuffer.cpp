@@ -0,0 +1,82 @@
+#include "StreamBuffer.h"
+
+StreamBuffer::StreamBuffer(GLenum target, size_t regionSize)
+    : target(target), regionSize(regionSize)
+{
+    const size_t totalSize = regionSize * kRegionCount;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+
+    if (GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage)
+    {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(target, totalSize, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(target, 0, totalSize, flags));
+    }
+
+    if (mapped == nullptr)
+    {
+        glBufferData(target, totalSize, nullptr, GL_STREAM_DRAW);
+        staging.resize(regionSize);
+    }
+
+    glBindBuffer(target, 0);
+}
+
+StreamBuffer::~StreamBuffer()
+{
+    for (GLsync& fence : fences)
+    {
+        if (fence) glDeleteSync(fence);
+    }
+    if (buffer != 0)
+    {
+        if (mapped != nullptr)
+        {
+            glBindBuffer(target, buffer);
+            glUnmapBuffer(target);
+            glBindBuffer(target, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+}
+
+void* StreamBuffer::Map()
+{
+    if (mapped == nullptr) return staging.data();
+
+    GLsync& fence = fences[region];
+    if (fence)
+    {
+        // Usually already signaled; only a GPU running kRegionCount frames behind makes us wait
+        GLenum result = glClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            ++stallCount;
+            do
+            {
+                result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+    return mapped + GetOffset();
+}
+
+void StreamBuffer::Commit(size_t bytes)
+{
+    if (mapped != nullptr || bytes == 0) return;
+
+    glBindBuffer(target, buffer);
+    glBufferSubData(target, GetOffset(), bytes, staging.data());
+    glBindBuffer(target, 0);
+}
+
+void StreamBuffer::Fence()
+{
+    if (mapped != nullptr)
+        fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    region = (region + 1) % kRegionCount;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+#include <vector>
+
+// Ring of kRegionCount equally sized regions in one persistently mapped buffer
+// (glBufferStorage + GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT), for data rewritten every frame.
+// Per frame: Map() -> write -> Commit() -> draw from GetOffset() -> Fence().
+// Map() only blocks if the GPU is still reading the region from kRegionCount frames ago.
+// Without GL 4.4 / ARB_buffer_storage it falls back to a CPU staging copy + glBufferSubData.
+class StreamBuffer
+{
+public:
+    static constexpr int kRegionCount = 3;
+
+    StreamBuffer(GLenum target, size_t regionSize);
+    ~StreamBuffer();
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    // Write pointer for the current region (regionSize bytes), after its fence has signaled
+    void* Map();
+
+    // Makes the first `bytes` written since Map() visible to the GPU (a no-op when persistently mapped)
+    void Commit(size_t bytes);
+
+    // Fences the current region after the draws reading it were issued, then moves to the next one
+    void Fence();
+
+    GLuint GetBuffer() const { return buffer; }
+    GLenum GetTarget() const { return target; }
+    size_t GetRegionSize() const { return regionSize; }
+    int GetRegionIndex() const { return region; }
+    size_t GetOffset() const { return static_cast<size_t>(region) * regionSize; }
+    bool IsPersistent() const { return mapped != nullptr; }
+
+    // Number of Map() calls that had to wait for the GPU
+    size_t GetStallCount() const { return stallCount; }
+
+private:
+    GLenum target;
+    size_t regionSize;
+    GLuint buffer = 0;
+
+    unsigned char* mapped = nullptr;     // whole buffer, persistent path only
+    std::vector<unsigned char> staging;  // fallback path only
+    GLsync fences[kRegionCount] = {};
+    int region = 0;
+
+    size_t stallCount = 0;
+};
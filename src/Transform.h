@@ -0,0 +1,152 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cmath>
+
+#include "Collision.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define TRANSFORM_SSE2 1
+#endif
+
+// Compact local transform: matrix = translate(position) * rotate(rotation) * scale(scale).
+// 40 bytes instead of a 64-byte mat4; animation code sets the parts directly.
+struct TRS
+{
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    glm::vec3 scale = glm::vec3(1.0f);
+
+    bool operator==(const TRS& o) const { return position == o.position && rotation == o.rotation && scale == o.scale; }
+    bool operator!=(const TRS& o) const { return !(*this == o); }
+};
+
+// Affine transform as the top three rows of a 4x4 matrix (48 bytes); the bottom row is
+// implicitly (0, 0, 0, 1). rows[r] = (m[0][r], m[1][r], m[2][r], m[3][r]) for glm's column-major m,
+// so a row is one SIMD register.
+struct Affine3x4
+{
+    glm::vec4 rows[3] = { glm::vec4(1.0f, 0.0f, 0.0f, 0.0f), glm::vec4(0.0f, 1.0f, 0.0f, 0.0f), glm::vec4(0.0f, 0.0f, 1.0f, 0.0f) };
+
+    // Drops the bottom row (projective matrices are not supported)
+    static Affine3x4 FromMat4(const glm::mat4& m)
+    {
+        Affine3x4 a;
+        for (int r = 0; r < 3; ++r)
+            a.rows[r] = glm::vec4(m[0][r], m[1][r], m[2][r], m[3][r]);
+        return a;
+    }
+
+    glm::mat4 ToMat4() const
+    {
+        glm::mat4 m(1.0f);
+        for (int c = 0; c < 4; ++c)
+        {
+            m[c][0] = rows[0][c];
+            m[c][1] = rows[1][c];
+            m[c][2] = rows[2][c];
+        }
+        return m;
+    }
+
+    glm::vec3 GetTranslation() const { return glm::vec3(rows[0].w, rows[1].w, rows[2].w); }
+    void SetTranslation(const glm::vec3& t)
+    {
+        rows[0].w = t.x;
+        rows[1].w = t.y;
+        rows[2].w = t.z;
+    }
+
+    glm::vec3 TransformPoint(const glm::vec3& p) const
+    {
+        const glm::vec4 h(p, 1.0f);
+        return glm::vec3(glm::dot(rows[0], h), glm::dot(rows[1], h), glm::dot(rows[2], h));
+    }
+};
+
+// T * R * S as an affine matrix
+inline Affine3x4 ComposeTRS(const TRS& t)
+{
+    const glm::quat& q = t.rotation;
+    const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    const glm::vec3& s = t.scale;
+
+    Affine3x4 a;
+    a.rows[0] = glm::vec4((1.0f - 2.0f * (yy + zz)) * s.x, 2.0f * (xy - wz) * s.y, 2.0f * (xz + wy) * s.z, t.position.x);
+    a.rows[1] = glm::vec4(2.0f * (xy + wz) * s.x, (1.0f - 2.0f * (xx + zz)) * s.y, 2.0f * (yz - wx) * s.z, t.position.y);
+    a.rows[2] = glm::vec4(2.0f * (xz - wy) * s.x, 2.0f * (yz + wx) * s.y, (1.0f - 2.0f * (xx + yy)) * s.z, t.position.z);
+    return a;
+}
+
+// a * b (apply b, then a)
+inline Affine3x4 MultiplyAffine(const Affine3x4& a, const Affine3x4& b)
+{
+    Affine3x4 out;
+#if defined(TRANSFORM_SSE2)
+    // out.row[r] = sum_k a[r][k] * b.row[k], with b's implicit bottom row (0, 0, 0, 1)
+    const __m128 b0 = _mm_loadu_ps(&b.rows[0].x);
+    const __m128 b1 = _mm_loadu_ps(&b.rows[1].x);
+    const __m128 b2 = _mm_loadu_ps(&b.rows[2].x);
+    const __m128 b3 = _mm_set_ps(1.0f, 0.0f, 0.0f, 0.0f);
+    for (int r = 0; r < 3; ++r)
+    {
+        const __m128 ar = _mm_loadu_ps(&a.rows[r].x);
+        __m128 row = _mm_mul_ps(_mm_shuffle_ps(ar, ar, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_shuffle_ps(ar, ar, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_shuffle_ps(ar, ar, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+        row = _mm_add_ps(row, _mm_mul_ps(_mm_shuffle_ps(ar, ar, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+        _mm_storeu_ps(&out.rows[r].x, row);
+    }
+#else
+    for (int r = 0; r < 3; ++r)
+    {
+        const glm::vec4& ar = a.rows[r];
+        out.rows[r] = ar.x * b.rows[0] + ar.y * b.rows[1] + ar.z * b.rows[2] + glm::vec4(0.0f, 0.0f, 0.0f, ar.w);
+    }
+#endif
+    return out;
+}
+
+// Splits m into T * R * S. Returns false if it is not representable that way (shear from a
+// non-uniform scale under a rotation, zero scale, projection); out is left untouched then.
+inline bool DecomposeTRS(const glm::mat4& m, TRS& out)
+{
+    if (m[0][3] != 0.0f || m[1][3] != 0.0f || m[2][3] != 0.0f || m[3][3] != 1.0f) return false;
+
+    glm::vec3 axes[3] = { glm::vec3(m[0]), glm::vec3(m[1]), glm::vec3(m[2]) };
+    glm::vec3 scale(glm::length(axes[0]), glm::length(axes[1]), glm::length(axes[2]));
+    if (scale.x < 1e-8f || scale.y < 1e-8f || scale.z < 1e-8f) return false;
+
+    // A mirror is folded into a negative x scale
+    if (glm::determinant(glm::mat3(axes[0], axes[1], axes[2])) < 0.0f) scale.x = -scale.x;
+    for (int i = 0; i < 3; ++i)
+        axes[i] /= scale[i];
+
+    // The scaled axes must still be perpendicular, otherwise the matrix carries a shear
+    constexpr float kTolerance = 1e-4f;
+    if (std::abs(glm::dot(axes[0], axes[1])) > kTolerance || std::abs(glm::dot(axes[0], axes[2])) > kTolerance ||
+        std::abs(glm::dot(axes[1], axes[2])) > kTolerance)
+    {
+        return false;
+    }
+
+    out.position = glm::vec3(m[3]);
+    out.rotation = glm::normalize(glm::quat_cast(glm::mat3(axes[0], axes[1], axes[2])));
+    out.scale = scale;
+    return true;
+}
+
+// World-space box enclosing local transformed by m (same as the mat4 overload in Collision.h)
+inline AABB TransformAABB(const AABB& local, const Affine3x4& m)
+{
+    const glm::vec3 center = m.TransformPoint((local.min + local.max) * 0.5f);
+    const glm::vec3 half = (local.max - local.min) * 0.5f;
+    const glm::vec3 extent(glm::dot(glm::abs(glm::vec3(m.rows[0])), half),
+                           glm::dot(glm::abs(glm::vec3(m.rows[1])), half),
+                           glm::dot(glm::abs(glm::vec3(m.rows[2])), half));
+    return AABB{ center - extent, center + extent };
+}
@@ -0,0 +1,381 @@
+#include "TransformHierarchy.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+TransformHierarchy::~TransformHierarchy()
+{
+    Release();
+}
+
+void TransformHierarchy::Build(const SceneNode::Ptr& newRoot)
+{
+    Release();
+    root = newRoot;
+    if (!root) return;
+
+    // Iterative pre-order DFS (children pushed in reverse to keep their order),
+    // which guarantees every parent is stored before its children.
+    std::vector<std::pair<SceneNode*, int32_t>> stack;
+    stack.emplace_back(root.get(), -1);
+
+    while (!stack.empty())
+    {
+        auto [node, parentIndex] = stack.back();
+        stack.pop_back();
+
+        const uint32_t index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(node);
+        parents.push_back(parentIndex);
+        locals.emplace_back();
+        LoadLocal(index, node);
+        globals.push_back(node->globalTransform);
+
+        AABB local;
+        const bool bounded = node->GetLocalBounds(local);
+        localBounds.push_back(bounded ? local : EmptyAABB());
+        hasBounds.push_back(bounded ? 1 : 0);
+        const MeshNode* mesh = NodeCast<MeshNode>(node);
+        meshIds.push_back(mesh ? mesh->GetMeshId() : MeshTable::kNoMesh);
+
+        node->hierarchy = this;
+        node->hierarchyIndex = index;
+
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it)
+        {
+            if (*it) stack.emplace_back(it->get(), static_cast<int32_t>(index));
+        }
+    }
+
+    // Subtree ranges: walking backwards, every node extends its parent's range.
+    const size_t count = nodes.size();
+    subtreeEnd.resize(count);
+    for (size_t i = 0; i < count; ++i)
+        subtreeEnd[i] = static_cast<uint32_t>(i + 1);
+    boundedCount.resize(count);
+    for (size_t i = 0; i < count; ++i)
+        boundedCount[i] = hasBounds[i];
+    for (size_t i = count; i-- > 1;)
+    {
+        const int32_t p = parents[i];
+        subtreeEnd[p] = std::max(subtreeEnd[p], subtreeEnd[i]);
+        boundedCount[p] += boundedCount[i];
+    }
+
+    // Filled by the first update (the whole tree is dirty)
+    worldBounds.assign(count, EmptyAABB());
+    subtreeBounds.assign(count, EmptyAABB());
+    ancestorQueued.assign(count, 0);
+    staleAncestors.clear();
+
+    // Freshly compiled: the root subtree (everything) needs one full pass.
+    dirty.assign(count, 0);
+    dirtyRoots.clear();
+    dirty[0] = 1;
+    dirtyRoots.push_back(0);
+
+    structureChanged = false;
+}
+
+void TransformHierarchy::SetLocal(uint32_t index, const TRS& trs, const Affine3x4* sheared)
+{
+    const auto it = std::lower_bound(shearedNodes.begin(), shearedNodes.end(), index);
+    const size_t k = static_cast<size_t>(it - shearedNodes.begin());
+    const bool wasSheared = it != shearedNodes.end() && *it == index;
+
+    // Animation code often re-applies an unchanged transform; don't dirty the subtree for it.
+    if (locals[index] == trs)
+    {
+        if (!sheared && !wasSheared) return;
+        if (sheared && wasSheared)
+        {
+            const Affine3x4& current = shearedLocals[k];
+            if (current.rows[0] == sheared->rows[0] && current.rows[1] == sheared->rows[1] &&
+                current.rows[2] == sheared->rows[2])
+            {
+                return;
+            }
+        }
+    }
+
+    locals[index] = trs;
+    if (sheared)
+    {
+        if (wasSheared)
+        {
+            shearedLocals[k] = *sheared;
+        }
+        else
+        {
+            shearedNodes.insert(it, index);
+            shearedLocals.insert(shearedLocals.begin() + k, *sheared);
+        }
+    }
+    else if (wasSheared)
+    {
+        shearedNodes.erase(it);
+        shearedLocals.erase(shearedLocals.begin() + k);
+    }
+
+    if (!dirty[index])
+    {
+        dirty[index] = 1;
+        dirtyRoots.push_back(index);
+    }
+}
+
+void TransformHierarchy::LoadLocal(uint32_t index, const SceneNode* node)
+{
+    locals[index] = node->localTRS;
+    if (node->shearedLocal)
+    {
+        // Build visits nodes in index order, so the list stays sorted
+        shearedNodes.push_back(index);
+        shearedLocals.push_back(*node->shearedLocal);
+    }
+}
+
+const Affine3x4* TransformHierarchy::FindShearedLocal(uint32_t index) const
+{
+    const auto it = std::lower_bound(shearedNodes.begin(), shearedNodes.end(), index);
+    if (it == shearedNodes.end() || *it != index) return nullptr;
+    return &shearedLocals[it - shearedNodes.begin()];
+}
+
+void TransformHierarchy::StoreTransforms(uint32_t index, SceneNode* node) const
+{
+    node->localTRS = locals[index];
+    if (const Affine3x4* sheared = FindShearedLocal(index)) node->shearedLocal = std::make_unique<Affine3x4>(*sheared);
+    else node->shearedLocal.reset();
+    node->globalTransform = globals[index];
+}
+
+void TransformHierarchy::Release()
+{
+    for (size_t i = 0; i < nodes.size(); ++i)
+    {
+        SceneNode* node = nodes[i];
+        if (!node) continue;
+        StoreTransforms(static_cast<uint32_t>(i), node);
+        node->transformDirty = true; // locals may have changed since the last sweep
+        node->hierarchy = nullptr;
+        node->hierarchyIndex = 0;
+    }
+
+    nodes.clear();
+    parents.clear();
+    locals.clear();
+    shearedNodes.clear();
+    shearedLocals.clear();
+    globals.clear();
+    subtreeEnd.clear();
+    localBounds.clear();
+    worldBounds.clear();
+    subtreeBounds.clear();
+    hasBounds.clear();
+    meshIds.clear();
+    boundedCount.clear();
+    ancestorQueued.clear();
+    staleAncestors.clear();
+    dirty.clear();
+    dirtyRoots.clear();
+    root.reset();
+    structureChanged = false;
+}
+
+void TransformHierarchy::Detach(SceneNode* node)
+{
+    if (!node || node->hierarchy != this) return;
+
+    const uint32_t index = node->hierarchyIndex;
+    StoreTransforms(index, node);
+    node->transformDirty = true;
+    node->hierarchy = nullptr;
+    node->hierarchyIndex = 0;
+    nodes[index] = nullptr;
+    meshIds[index] = MeshTable::kNoMesh;
+
+    for (auto& c : node->children)
+        Detach(c.get());
+}
+
+size_t TransformHierarchy::UpdateGlobalTransforms()
+{
+    if (structureChanged)
+    {
+        SceneNode::Ptr keep = root;
+        Build(keep);
+    }
+
+    // Parents have lower indices than their children, so processing dirty roots in
+    // ascending order guarantees a parent range is finished before any nested one;
+    // roots already covered by an earlier range are skipped.
+    std::sort(dirtyRoots.begin(), dirtyRoots.end());
+
+    size_t count = 0;
+    uint32_t coveredEnd = 0;
+    for (uint32_t r : dirtyRoots)
+    {
+        dirty[r] = 0;
+        if (r < coveredEnd) continue;
+
+        const uint32_t end = subtreeEnd[r];
+
+        // Sheared nodes are walked alongside the range, so the common case reads no extra array
+        size_t nextShear = static_cast<size_t>(
+            std::lower_bound(shearedNodes.begin(), shearedNodes.end(), r) - shearedNodes.begin());
+        uint32_t nextShearIndex = nextShear < shearedNodes.size() ? shearedNodes[nextShear] : end;
+
+        for (uint32_t i = r; i < end; ++i)
+        {
+            // Matrices only exist here: the TRS is composed on the fly, never stored
+            const int32_t p = parents[i];
+            Affine3x4 local;
+            if (i != nextShearIndex)
+            {
+                local = ComposeTRS(locals[i]);
+            }
+            else
+            {
+                local = shearedLocals[nextShear++];
+                nextShearIndex = nextShear < shearedNodes.size() ? shearedNodes[nextShear] : end;
+            }
+            globals[i] = (p < 0) ? local : MultiplyAffine(globals[p], local);
+        }
+        RefitBounds(r, end);
+        count += end - r;
+        coveredEnd = end;
+    }
+    dirtyRoots.clear();
+
+    // Ancestors of the refit ranges, children first (higher index = deeper or later sibling)
+    std::sort(staleAncestors.begin(), staleAncestors.end(), std::greater<uint32_t>());
+    for (uint32_t a : staleAncestors)
+    {
+        AABB box = worldBounds[a];
+        for (uint32_t c = a + 1; c < subtreeEnd[a]; c = subtreeEnd[c])
+            MergeAABB(box, subtreeBounds[c]);
+        subtreeBounds[a] = box;
+        ancestorQueued[a] = 0;
+    }
+    staleAncestors.clear();
+
+    lastRecomputedCount = count;
+    return count;
+}
+
+void TransformHierarchy::RefitBounds(uint32_t begin, uint32_t end)
+{
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        worldBounds[i] = hasBounds[i] ? TransformAABB(localBounds[i], globals[i]) : EmptyAABB();
+        subtreeBounds[i] = worldBounds[i];
+    }
+
+    // Children come after their parent, so a backwards sweep folds every subtree into its parent
+    for (uint32_t i = end; i-- > begin + 1;)
+        MergeAABB(subtreeBounds[parents[i]], subtreeBounds[i]);
+
+    for (int32_t a = parents[begin]; a >= 0 && !ancestorQueued[a]; a = parents[a])
+    {
+        ancestorQueued[a] = 1;
+        staleAncestors.push_back(static_cast<uint32_t>(a));
+    }
+}
+
+void TransformHierarchy::CullFrustum(const Frustum& frustum, const SceneNode* subtreeRoot,
+                                     std::vector<SceneNode*>& visible, FrustumCullStats& stats,
+                                     const OcclusionCuller* occlusion) const
+{
+    if (!subtreeRoot || subtreeRoot->hierarchy != this) return;
+
+    // True (and counted) if the occlusion buffer hides box, which holds the given number of meshes
+    auto occluded = [&](const AABB& box, size_t meshes) {
+        if (!occlusion) return false;
+        ++stats.tested;
+        if (!occlusion->IsOccluded(box)) return false;
+        stats.culled += meshes;
+        stats.occluded += meshes;
+        return true;
+    };
+
+    const uint32_t begin = subtreeRoot->hierarchyIndex;
+    const uint32_t end = subtreeEnd[begin];
+    bool insideFrustum = false; // set while walking a subtree that is fully inside
+    uint32_t insideEnd = 0;
+    for (uint32_t i = begin; i < end;)
+    {
+        if (boundedCount[i] == 0)
+        {
+            i = subtreeEnd[i];
+            continue;
+        }
+
+        if (insideFrustum && i >= insideEnd) insideFrustum = false;
+
+        Frustum::Result result = Frustum::Result::Inside;
+        if (!insideFrustum)
+        {
+            ++stats.tested;
+            result = frustum.Classify(subtreeBounds[i]);
+            if (result == Frustum::Result::Outside)
+            {
+                stats.culled += boundedCount[i];
+                i = subtreeEnd[i];
+                continue;
+            }
+        }
+
+        if (occluded(subtreeBounds[i], boundedCount[i]))
+        {
+            i = subtreeEnd[i];
+            continue;
+        }
+
+        if (result == Frustum::Result::Inside && !occlusion)
+        {
+            for (uint32_t j = i; j < subtreeEnd[i]; ++j)
+            {
+                if (hasBounds[j] && nodes[j]) visible.push_back(nodes[j]);
+            }
+            stats.drawn += boundedCount[i];
+            i = subtreeEnd[i];
+            continue;
+        }
+        if (result == Frustum::Result::Inside && !insideFrustum)
+        {
+            // Descendants skip the frustum test but still get their own occlusion test
+            insideFrustum = true;
+            insideEnd = subtreeEnd[i];
+        }
+
+        // The node's own geometry decides for itself (a leaf's subtree box is its own),
+        // then its children are visited in turn
+        if (hasBounds[i])
+        {
+            bool visibleSelf = true;
+            if (subtreeEnd[i] != i + 1)
+            {
+                if (!insideFrustum)
+                {
+                    ++stats.tested;
+                    if (frustum.Classify(worldBounds[i]) == Frustum::Result::Outside)
+                    {
+                        visibleSelf = false;
+                        ++stats.culled;
+                    }
+                }
+                if (visibleSelf && occluded(worldBounds[i], 1))
+                    visibleSelf = false;
+            }
+
+            if (visibleSelf && nodes[i])
+            {
+                visible.push_back(nodes[i]);
+                ++stats.drawn;
+            }
+        }
+        ++i;
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "Collision.h"
+#include "Frustum.h"
+#include "MeshNode.h"
+#include "OcclusionCuller.h"
+#include "SceneNode.h"
+
+// Counters of TransformHierarchy::CullFrustum (accumulated across calls until reset)
+struct FrustumCullStats
+{
+    size_t tested = 0; // box/frustum tests performed
+    size_t culled = 0; // nodes with geometry rejected
+    size_t occluded = 0; // of which rejected by the occlusion test
+    size_t drawn = 0;  // nodes with geometry returned as visible
+};
+
+// Linearized (depth-first) copy of a SceneNode tree:
+// - parents[i] is the index of node i's parent (-1 for the root), always < i
+// - subtreeEnd[i] is one past the last descendant of i, so [i, subtreeEnd[i]) is its subtree
+// - locals[i] is node i's TRS, composed into a matrix only by the update pass; a sheared local
+//   (not expressible as TRS, rare) is listed in shearedNodes, its matrix in shearedLocals
+// - globals[i] is node i's world transform as a 3x4 affine matrix
+// - meshIds[i] is node i's MeshTable id (kNoMesh if it is not a MeshNode)
+// - worldBounds[i] is node i's own geometry box in world space (empty if it draws nothing),
+//   subtreeBounds[i] the union over [i, subtreeEnd[i]); both are refit with the globals
+// Once compiled, SceneNode transform getters/setters read and write these arrays.
+// Setting a local marks the node dirty and the update pass only sweeps the
+// contiguous ranges of dirty subtrees.
+class TransformHierarchy
+{
+public:
+    TransformHierarchy() = default;
+    ~TransformHierarchy();
+
+    TransformHierarchy(const TransformHierarchy&) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy&) = delete;
+
+    // Compiles the tree under root (releases any previously compiled tree first).
+    void Build(const SceneNode::Ptr& root);
+
+    // Copies transforms back into the nodes and detaches them from this hierarchy.
+    void Release();
+
+    // global[i] = global[parent[i]] * local[i] for every node in a dirty subtree.
+    // Rebuilds (and recomputes everything) if the tree structure changed since the last Build.
+    // Returns the number of global transforms recomputed.
+    size_t UpdateGlobalTransforms();
+
+    // Appends to visible every node with geometry in subtreeRoot's subtree whose bounds may
+    // intersect the frustum. A subtree whose bounds are outside is rejected with one test,
+    // one fully inside is accepted without testing its descendants against the frustum.
+    // With an occlusion culler, every subtree that passes is also tested against its depth
+    // buffer, so a group hidden behind the occluders is rejected as a whole.
+    // subtreeRoot must be compiled into this hierarchy; bounds are those of the last update.
+    void CullFrustum(const Frustum& frustum, const SceneNode* subtreeRoot,
+                     std::vector<SceneNode*>& visible, FrustumCullStats& stats,
+                     const OcclusionCuller* occlusion = nullptr) const;
+
+    // Calls fn(const glm::mat4& global, uint32_t meshId) for every MeshNode in subtreeRoot's
+    // subtree, in depth-first order. Reads only the flat arrays (no node access); look the mesh
+    // data up in the MeshTable. subtreeRoot must be compiled into this hierarchy.
+    template <typename Fn>
+    void ForEachMesh(const SceneNode* subtreeRoot, Fn&& fn) const;
+
+    // Nodes recomputed by the last UpdateGlobalTransforms()
+    size_t GetLastRecomputedCount() const { return lastRecomputedCount; }
+
+    size_t Size() const { return nodes.size(); }
+    bool Empty() const { return nodes.empty(); }
+
+    const std::vector<SceneNode*>& GetNodes() const { return nodes; }
+    const std::vector<int32_t>& GetParents() const { return parents; }
+    const std::vector<uint32_t>& GetMeshIds() const { return meshIds; }
+    const std::vector<uint32_t>& GetSubtreeEnds() const { return subtreeEnd; }
+    const std::vector<Affine3x4>& GetGlobalTransforms() const { return globals; }
+    const std::vector<AABB>& GetWorldBounds() const { return worldBounds; }
+    const std::vector<AABB>& GetSubtreeBounds() const { return subtreeBounds; }
+
+private:
+    friend class SceneNode;
+
+    // Called by SceneNode when children are added/removed on a compiled node.
+    void MarkStructureChanged() { structureChanged = true; }
+
+    // Called by the SceneNode local setters on a compiled node; sheared may be null.
+    void SetLocal(uint32_t index, const TRS& trs, const Affine3x4* sheared);
+
+    // Sheared local matrix of node index, or nullptr
+    const Affine3x4* FindShearedLocal(uint32_t index) const;
+
+    // Node -> hierarchy copy of the local transform at Build, and back at Release / Detach
+    void LoadLocal(uint32_t index, const SceneNode* node);
+    void StoreTransforms(uint32_t index, SceneNode* node) const;
+
+    // Detaches node and its descendants (used when a subtree is removed).
+    void Detach(SceneNode* node);
+
+    // Recomputes world/subtree bounds of [begin, end) (globals already updated) and queues the
+    // ancestors of begin, whose subtree bounds are refit once all ranges are done.
+    void RefitBounds(uint32_t begin, uint32_t end);
+
+    SceneNode::Ptr root;
+    std::vector<SceneNode*> nodes;
+    std::vector<int32_t> parents;
+    std::vector<TRS> locals;
+    std::vector<uint32_t> shearedNodes;     // ascending indices of nodes with a sheared local
+    std::vector<Affine3x4> shearedLocals;   // parallel to shearedNodes
+    std::vector<Affine3x4> globals;
+    std::vector<uint32_t> subtreeEnd;
+    std::vector<AABB> localBounds;
+    std::vector<AABB> worldBounds;
+    std::vector<AABB> subtreeBounds;
+    std::vector<uint8_t> hasBounds;
+    std::vector<uint32_t> meshIds;
+    std::vector<uint32_t> boundedCount;     // nodes with geometry in each subtree
+    std::vector<uint8_t> ancestorQueued;    // 1 if the node is in staleAncestors
+    std::vector<uint32_t> staleAncestors;   // ancestors of refit ranges, scratch of the update pass
+    std::vector<uint8_t> dirty;        // 1 if the node is already in dirtyRoots
+    std::vector<uint32_t> dirtyRoots;  // nodes whose local changed since the last update
+    bool structureChanged = false;
+    size_t lastRecomputedCount = 0;
+};
+
+template <typename Fn>
+void TransformHierarchy::ForEachMesh(const SceneNode* subtreeRoot, Fn&& fn) const
+{
+    if (!subtreeRoot || subtreeRoot->hierarchy != this) return;
+
+    const uint32_t begin = subtreeRoot->hierarchyIndex;
+    const uint32_t end = subtreeEnd[begin];
+    for (uint32_t i = begin; i < end; ++i)
+    {
+        if (meshIds[i] != MeshTable::kNoMesh) fn(globals[i].ToMat4(), meshIds[i]);
+    }
+}
@@ -7,6 +7,11 @@
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <unordered_map>
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -15,9 +20,20 @@
 #include "SceneNode.h"
 #include "Player.h"
 #include "Collision.h"
+#include "CollisionWorld.h"
 #include "GLUtils.h"
 #include "SchoolBuilder.h"
-#include "ParticleSystem.h" // Add Particle System
+#include "ParticleManager.h" // Add Particle System
+#include "GpuParticleSystem.h"
+#include "JobSystem.h"
+#include "InstancedRenderer.h"
+#include "StaticBatcher.h"
+#include "TransformHierarchy.h"
+#include "Frustum.h"
+#include "OcclusionCuller.h"
+#include "LightManager.h"
+#include "LightClusterer.h"
+#include "SceneBVH.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -52,6 +68,28 @@ struct ButtonBounds {
 };
 static std::vector<ButtonBounds> g_controlPanelButtons;
 
+// Renderer mode: instanced (one draw per MeshType) or the recursive per-node path
+static bool g_useInstancing = true;
+static bool g_useStaticBatching = true; // Frozen geometry drawn from StaticBatcher's merged buffer
+static size_t g_drawCallCount = 0; // Scene draw calls issued in the current frame
+static size_t g_transformsRecomputed = 0; // Global transforms recomputed so far in the current frame
+static size_t g_lastFrameTransformsRecomputed = 0; // Total of the previous frame (shown in the UI)
+static bool g_useFrustumCulling = true;
+static FrustumCullStats g_cullStats; // Dynamic / per-node meshes tested, culled and drawn this frame
+static bool g_useOcclusionCulling = true; // Needs frustum culling; tests bounds against the CPU depth buffer
+static bool g_showOcclusionBuffer = false;
+
+// Point-light shading: clustered (per-cluster light lists) or the brute-force loop over all lights
+static bool g_useClusteredLighting = true;
+static int g_stressLightCount = 0; // Extra random lights for benchmarking (added on top of the school's lights)
+
+static double g_pickQueryUs = 0.0; // Duration of this frame's crosshair ray query (microseconds)
+
+// Fountain simulation: CPU (ParticleManager) or compute shader (GpuParticleSystem, GL 4.3+)
+static bool g_useGpuParticles = false;
+static int g_stressEmitterCount = 0; // Extra random emitters for benchmarking (on top of the fountain)
+static int g_workerThreadCount = static_cast<int>(JobSystem::DefaultThreadCount()); // 0: update on the render thread
+
 // Mouse callback to forward movement to the Camera
 static void mouse_callback(GLFWwindow* /*window*/, double xpos, double ypos)
 {
@@ -206,9 +244,9 @@ static void CollectColliders(const SceneNode::Ptr& node, std::vector<AABB>& boxe
         if (node == excluded) return;
     }
 
-    if (auto meshNode = std::dynamic_pointer_cast<MeshNode>(node)) {
+    if (const MeshNode* meshNode = NodeCast<MeshNode>(node.get())) {
         // Only collide with Cubes (walls, posts)
-        if (meshNode->mesh == MeshType::Cube) {
+        if (meshNode->GetMeshType() == MeshType::Cube) {
              AABB box = GetAABBFromTransform(meshNode->GetGlobalTransform());
              // Filter small objects (leaves, thin frames, etc) if needed
              // For now, only ignore very thin things if they are not walls
@@ -225,6 +263,20 @@ static void CollectColliders(const SceneNode::Ptr& node, std::vector<AABB>& boxe
     }
 }
 
+// Meshes flagged as occluders by SchoolBuilder (wing walls, floors, roofs)
+static void CollectOccluders(const SceneNode::Ptr& node, std::vector<const SceneNode*>& out)
+{
+    if (!node) return;
+
+    if (const MeshNode* meshNode = NodeCast<MeshNode>(node.get()))
+    {
+        if (meshNode->IsOccluder()) out.push_back(meshNode);
+    }
+
+    for (auto& child : node->children)
+        CollectOccluders(child, out);
+}
+
 // Process keyboard input (Lighting only - movement handled by Player)
 static void processLightingInput(GLFWwindow* window)
 {
@@ -323,75 +375,312 @@ static void processLightingInput(GLFWwindow* window)
     }
 }
 
-// Recursive render of SceneNode tree. Uses MeshNode metadata from SchoolBuilder.h
-static void RenderNode(const SceneNode::Ptr& node, Shader& shader, GLuint cubeVAO, GLuint planeVAO, GLuint pyramidVAO, GLuint cylinderVAO, GLuint coneVAO, GLuint sphereVAO)
+// Pre-resolved uniform handles for scene_lighting (resolved once after linking,
+// so the render loop does no string building and no glGetUniformLocation calls)
+struct SceneUniforms
 {
-    if (!node) return;
+    Uniform<glm::mat4> model, view, projection, sunModel;
+    Uniform<glm::vec3> albedo, sunColor, sceneCenter, ambientColor;
+    Uniform<float> sunIntensity;
+    Uniform<glm::vec3> sunLightDirection, sunLightColor, moonLightDirection, moonLightColor;
+    Uniform<float> sunLightIntensity, moonLightIntensity;
+    Uniform<bool> useClusteredLighting;
+    Uniform<glm::vec2> clusterScreenSize;
+    Uniform<float> clusterSliceScale, clusterSliceBias;
+    Uniform<int> pointLightData, clusterGrid, clusterLightIndices;
+
+    explicit SceneUniforms(const Shader& shader)
+    {
+        model = shader.GetUniform<glm::mat4>("model");
+        view = shader.GetUniform<glm::mat4>("view");
+        projection = shader.GetUniform<glm::mat4>("projection");
+        sunModel = shader.GetUniform<glm::mat4>("sunModel");
+        albedo = shader.GetUniform<glm::vec3>("albedo");
+        sunColor = shader.GetUniform<glm::vec3>("sunColor");
+        sceneCenter = shader.GetUniform<glm::vec3>("sceneCenter");
+        ambientColor = shader.GetUniform<glm::vec3>("ambientColor");
+        sunIntensity = shader.GetUniform<float>("sunIntensity");
+        sunLightDirection = shader.GetUniform<glm::vec3>("sunLightDirection");
+        sunLightColor = shader.GetUniform<glm::vec3>("sunLightColor");
+        sunLightIntensity = shader.GetUniform<float>("sunLightIntensity");
+        moonLightDirection = shader.GetUniform<glm::vec3>("moonLightDirection");
+        moonLightColor = shader.GetUniform<glm::vec3>("moonLightColor");
+        moonLightIntensity = shader.GetUniform<float>("moonLightIntensity");
+        useClusteredLighting = shader.GetUniform<bool>("useClusteredLighting");
+        clusterScreenSize = shader.GetUniform<glm::vec2>("clusterScreenSize");
+        clusterSliceScale = shader.GetUniform<float>("clusterSliceScale");
+        clusterSliceBias = shader.GetUniform<float>("clusterSliceBias");
+        pointLightData = shader.GetUniform<int>("pointLightData");
+        clusterGrid = shader.GetUniform<int>("clusterGrid");
+        clusterLightIndices = shader.GetUniform<int>("clusterLightIndices");
+    }
+};
 
-    // If MeshNode, set material and model and draw appropriate mesh
-    if (auto meshNode = std::dynamic_pointer_cast<MeshNode>(node))
+// Adds the school's static point lights (streetlights, statue/fountain accents, gate highlight)
+static void AddSchoolLights(LightManager& lights)
+{
+    // 10 central + 6 perimeter + 3 statue + 3 fountain + 4 corners + 12 horizontal path + 1 gate = 39 total
+    // Intensities are the full-brightness values; the on/off toggle and brightness slider
+    // are applied through LightManager::SetIntensityScale.
+    float lightHeight = 4.0f;
+
+    auto addPointLight = [&](const glm::vec3& position, const glm::vec3& color, float intensity) {
+        PointLight light;
+        light.position = position;
+        light.color = color;
+        light.intensity = intensity;
+        lights.Add(light);
+    };
+    
+    // Central pathway lights (10 lights in 5 symmetric pairs) - CONSTANT BRIGHTNESS
+    int numPairs = 5;
+    float spacing = 7.0f;
+    for (int i = 0; i < numPairs; ++i)
+    {
+        float z = 28.0f - i * spacing; // Z positions: 28, 21, 14, 7, 0
+        
+        // Left light - ALWAYS 3.5 intensity
+        addPointLight(glm::vec3(-2.5f, lightHeight, z), glm::vec3(1.0f, 0.9f, 0.7f), 3.5f);
+        
+        // Right light - ALWAYS 3.5 intensity
+        addPointLight(glm::vec3(2.5f, lightHeight, z), glm::vec3(1.0f, 0.9f, 0.7f), 3.5f);
+    }
+    
+    // Perimeter lights (6 lights around school - outside sports courts) - CONSTANT BRIGHTNESS
+    glm::vec3 perimeterLightPositions[] = {
+        glm::vec3(-32.0f, lightHeight, 0.0f),    // Left side 1 (outside basketball court)
+        glm::vec3(-39.0f, lightHeight, -15.0f),  // Left side 2 (adjusted by user)
+        glm::vec3(32.0f, lightHeight, 0.0f),     // Right side 1 (outside football field)
+        glm::vec3(39.0f, lightHeight, -15.0f),   // Right side 2 (adjusted by user)
+        glm::vec3(-15.0f, lightHeight, -20.0f),  // Back left
+        glm::vec3(15.0f, lightHeight, -20.0f)    // Back right
+    };
+    
+    for (int i = 0; i < 6; ++i)
+    {
+        addPointLight(perimeterLightPositions[i], glm::vec3(1.0f, 0.9f, 0.7f), 4.0f);
+    }
+    
+    // Statue spotlights (3 lights around statue) - CONSTANT BRIGHTNESS
+    // Statue is at position (-28, 0, 18), scaled 2.0x (in left front corner)
+    glm::vec3 statueLightPositions[] = {
+        glm::vec3(-28.0f, 5.0f, 21.0f),   // Front light (elevated for 2x scale)
+        glm::vec3(-25.0f, 6.0f, 18.0f),   // Right side light (higher)
+        glm::vec3(-31.0f, 5.0f, 15.0f)    // Back left light
+    };
+    
+    for (int i = 0; i < 3; ++i)
+    {
+        addPointLight(statueLightPositions[i], glm::vec3(1.0f, 0.95f, 0.8f), 5.0f); // Warm golden light
+    }
+    
+    // Fountain underwater lights (3 lights around fountain base) - CONSTANT BRIGHTNESS
+    // Fountain is at position (28, 0, 18), scaled 1.5x (in right front corner)
+    glm::vec3 fountainLightPositions[] = {
+        glm::vec3(28.0f, 1.0f, 21.5f),    // Front light (low, underwater effect)
+        glm::vec3(31.0f, 1.5f, 18.0f),    // Right side light
+        glm::vec3(25.0f, 1.0f, 14.5f)     // Back left light
+    };
+    
+    for (int i = 0; i < 3; ++i)
+    {
+        addPointLight(fountainLightPositions[i], glm::vec3(0.7f, 0.9f, 1.0f), 4.5f); // Cool blue-white water light
+    }
+    
+    // Corner lights (4 lights at school corners for better coverage)
+    glm::vec3 cornerLightPositions[] = {
+        glm::vec3(-35.0f, 5.0f, -20.0f),  // Back left corner
+        glm::vec3(35.0f, 5.0f, -20.0f),   // Back right corner
+        glm::vec3(-35.0f, 5.0f, 25.0f),   // Front left corner
+        glm::vec3(35.0f, 5.0f, 25.0f)     // Front right corner
+    };
+    
+    for (int i = 0; i < 4; ++i)
     {
-        shader.SetMat4("model", meshNode->GetGlobalTransform());
-        shader.SetVec3("albedo", meshNode->material.albedo);
+        addPointLight(cornerLightPositions[i], glm::vec3(1.0f, 0.9f, 0.7f), 5.0f); // Warm white
+    }
 
-        if (meshNode->mesh == MeshType::Cube)
-        {
-            glBindVertexArray(cubeVAO);
-            glDrawArrays(GL_TRIANGLES, 0, 36);
-        }
-        else if (meshNode->mesh == MeshType::Plane)
+    // Horizontal Pathway Lights (Expanded to cover 100m road)
+    // Positions matches SchoolBuilder: X from -45 to 45 step 15, Z = 40 +/- 6
+    float hLightZ = 40.0f;
+    for (float x = -45.0f; x <= 45.0f; x += 15.0f) {
+        if (std::abs(x) < 1.0f) continue; // Skip center light
+        
+        // Front side light (Z = 46)
+        addPointLight(glm::vec3(x, lightHeight, hLightZ + 6.0f), glm::vec3(1.0f, 0.9f, 0.7f), 3.5f);
+
+        // Back side light (Z = 34)
+        addPointLight(glm::vec3(x, lightHeight, hLightZ - 6.0f), glm::vec3(1.0f, 0.9f, 0.7f), 3.5f);
+    }
+
+    // Gate Highlight Light (One bright light in front of the gate)
+    // High up in front of the gate, very bright warm white, high intensity to highlight the gate
+    addPointLight(glm::vec3(0.0f, 6.0f, 38.0f), glm::vec3(1.0f, 0.98f, 0.9f), 8.0f);
+}
+
+// Benchmark lights: a deterministic jittered grid of small coloured lights over the campus,
+// low enough to light the ground and building walls.
+static void AddStressLights(LightManager& lights, int count)
+{
+    if (count <= 0) return;
+
+    std::mt19937 rng(1234u);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    const glm::vec2 areaMin(-45.0f, -25.0f);
+    const glm::vec2 areaMax(45.0f, 45.0f);
+    const int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count)))));
+    const glm::vec2 cell = (areaMax - areaMin) / static_cast<float>(columns);
+
+    for (int i = 0; i < count; ++i)
+    {
+        PointLight light;
+        light.position = glm::vec3(areaMin.x + (static_cast<float>(i % columns) + unit(rng)) * cell.x,
+                                   0.5f + 2.0f * unit(rng),
+                                   areaMin.y + (static_cast<float>(i / columns) + unit(rng)) * cell.y);
+        light.color = glm::vec3(0.3f + 0.7f * unit(rng), 0.3f + 0.7f * unit(rng), 0.3f + 0.7f * unit(rng));
+        light.intensity = 0.5f + unit(rng);
+        if (lights.Add(light) == lights.Capacity()) break;
+    }
+}
+
+// The school fountain: drips falling from the upper tier's rim plus the central jet
+static ParticleEmitterDesc MakeFountainEmitter(const glm::vec3& top)
+{
+    ParticleEmitterDesc fountain;
+    fountain.position = top;
+    fountain.rate = 600.0f;
+    fountain.floorY = 5.8f; // Update bound (approx tier 2 level)
+
+    ParticleSpawnDesc drip; // FALLING FROM EDGE: ring around the upper tier, slightly lower
+    drip.weight = 0.3f;     // 30% chance for cascading drips
+    drip.shape = ParticleSpawnDesc::Shape::Ring;
+    drip.offset = glm::vec3(0.0f, -0.6f, 0.0f);
+    drip.radius = 1.2f;
+    drip.velocityMin = drip.velocityMax = glm::vec3(0.0f, -1.0f, 0.0f); // Fall down
+    drip.radialSpeed = 0.24f;                                           // and slightly out
+    drip.color = glm::vec4(0.7f, 0.85f, 1.0f, 0.8f); // Slightly transparent
+    drip.life = 1.5f;
+
+    ParticleSpawnDesc jet; // CENTRAL JET
+    jet.weight = 0.7f;
+    jet.velocityMin = glm::vec3(-0.3f, 5.0f, -0.3f);
+    jet.velocityMax = glm::vec3(0.3f, 7.5f, 0.3f);
+    jet.color = glm::vec4(0.6f, 0.8f, 1.0f, 1.0f);
+    jet.life = 2.0f;
+
+    fountain.spawns = { drip, jet };
+    return fountain;
+}
+
+// Random fountains, lawn sprinklers and chimney smoke spread over the school grounds
+static void AddStressEmitters(ParticleManager& particles, int count)
+{
+    std::mt19937 rng(4321u);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    for (int i = 0; i < count; ++i)
+    {
+        const glm::vec3 ground(-45.0f + 90.0f * unit(rng), 0.0f, -25.0f + 70.0f * unit(rng));
+
+        ParticleEmitterDesc emitter;
+        switch (i % 3)
         {
-            glBindVertexArray(planeVAO);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-        }
-        else if (meshNode->mesh == MeshType::Pyramid)
+        case 0:
+            emitter = MakeFountainEmitter(ground + glm::vec3(0.0f, 1.0f, 0.0f));
+            emitter.floorY = 0.0f;
+            break;
+        case 1:
         {
-            glBindVertexArray(pyramidVAO);
-            glDrawArrays(GL_TRIANGLES, 0, 18);
+            ParticleSpawnDesc spray; // Sprinkler: wide, low arcs in every direction
+            spray.shape = ParticleSpawnDesc::Shape::Ring;
+            spray.radius = 0.1f;
+            spray.radialSpeed = 4.0f;
+            spray.velocityMin = glm::vec3(-0.5f, 2.0f, -0.5f);
+            spray.velocityMax = glm::vec3(0.5f, 3.5f, 0.5f);
+            spray.color = glm::vec4(0.7f, 0.85f, 1.0f, 0.9f);
+            spray.size = 6.0f;
+            spray.life = 1.2f;
+            emitter.position = ground + glm::vec3(0.0f, 0.2f, 0.0f);
+            emitter.rate = 300.0f;
+            emitter.floorY = 0.0f;
+            emitter.spawns = { spray };
+            break;
         }
-        else if (meshNode->mesh == MeshType::Cylinder)
+        default:
         {
-            glBindVertexArray(cylinderVAO);
-            // Cylinder: top/bottom fans + strips. 
-            // createCylinderVAO typically creates:
-            // Side: 32 segments * 6 verts = 192 (or 32 * 2 triangles)
-            // Top: 32 triangles = 96
-            // Bottom: 32 triangles = 96
-            // Total = 384?
-            // Safer to check GLUtils or just draw plenty if count unknown, but GLUtils usually follows standard counts.
-            // Let's assume standard count from common GLUtils implementations.
-            // If we don't know the count, we risk drawing garbage or crashing if VBO too small.
-            // Usually we pass indices count or size.
-            // Let's assume 360 or similar.
-            // Actually, let's use a safe assumption of 32 segments.
-            // Top Fan (TF): 32 tri = 32*3 = 96 verts
-            // Bottom Fan (BF): 96 verts
-            // Side Strip (SS): 32 * 6 = 192 verts
-            // Total = 384.
-            glDrawArrays(GL_TRIANGLES, 0, 384); 
-        }
-        else if (meshNode->mesh == MeshType::Cone)
-        {
-            glBindVertexArray(coneVAO);
-            // Cone: Base (96) + Side (96) = 192
-            glDrawArrays(GL_TRIANGLES, 0, 192);
+            ParticleSpawnDesc puff; // Chimney smoke: slow, buoyant, long-lived
+            puff.shape = ParticleSpawnDesc::Shape::Disc;
+            puff.radius = 0.4f;
+            puff.velocityMin = glm::vec3(-0.3f, 0.8f, -0.3f);
+            puff.velocityMax = glm::vec3(0.3f, 1.5f, 0.3f);
+            puff.color = glm::vec4(0.5f, 0.5f, 0.5f, 0.6f);
+            puff.size = 24.0f;
+            puff.life = 4.0f;
+            emitter.position = ground + glm::vec3(0.0f, 12.0f, 0.0f);
+            emitter.rate = 60.0f;
+            emitter.gravityScale = -0.02f;
+            emitter.spawns = { puff };
+            break;
         }
-        else if (meshNode->mesh == MeshType::Sphere) // Assuming Sphere added to enum? SchoolBuilder.h line 16 doesn't show Sphere.
-        {
-            glBindVertexArray(sphereVAO);
-            // Sphere UV 32x32: ~6000 verts?
-            // Let's hold off on Sphere if not in Enum.
-            // Wait, I saw createSphereVAO in GLUtils.h, but SchoolBuilder.h Enum might not have it.
-            // Enum had Cube, Plane, Pyramid, Cylinder, Cone. No Sphere.
-            // So meshNode->mesh == MeshType::Sphere is invalid if not added.
-            // We'll skip sphere for now or add to Enum if needed.
         }
-        glBindVertexArray(0);
+        particles.AddEmitter(emitter);
     }
+}
+
+// Draws a single mesh with its albedo and global transform
+static void DrawMesh(MeshType mesh, const glm::vec3& albedo, const glm::mat4& model, Shader& shader, const SceneUniforms& uniforms, GLuint cubeVAO, GLuint planeVAO, GLuint pyramidVAO, GLuint cylinderVAO, GLuint coneVAO, GLuint sphereVAO)
+{
+    shader.Set(uniforms.model, model);
+    shader.Set(uniforms.albedo, albedo);
+
+    if (mesh == MeshType::Cube)
+    {
+        glBindVertexArray(cubeVAO);
+        glDrawElements(GL_TRIANGLES, kCubeIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
+    else if (mesh == MeshType::Plane)
+    {
+        glBindVertexArray(planeVAO);
+        glDrawElements(GL_TRIANGLES, kPlaneIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
+    else if (mesh == MeshType::Pyramid)
+    {
+        glBindVertexArray(pyramidVAO);
+        glDrawElements(GL_TRIANGLES, kPyramidIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
+    else if (mesh == MeshType::Cylinder)
+    {
+        glBindVertexArray(cylinderVAO);
+        glDrawElements(GL_TRIANGLES, kCylinderIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
+    else if (mesh == MeshType::Cone)
+    {
+        glBindVertexArray(coneVAO);
+        glDrawElements(GL_TRIANGLES, kConeIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
+    else if (mesh == MeshType::Sphere)
+    {
+        glBindVertexArray(sphereVAO);
+        glDrawElements(GL_TRIANGLES, kSphereIndexCount, GL_UNSIGNED_INT, nullptr);
+    }
+    glBindVertexArray(0);
+    ++g_drawCallCount;
+}
+
+// Recursive render of SceneNode tree. Uses MeshNode metadata from SchoolBuilder.h
+static void RenderNode(const SceneNode::Ptr& node, Shader& shader, const SceneUniforms& uniforms, GLuint cubeVAO, GLuint planeVAO, GLuint pyramidVAO, GLuint cylinderVAO, GLuint coneVAO, GLuint sphereVAO)
+{
+    if (!node) return;
+
+    // If MeshNode, set material and model and draw appropriate mesh
+    if (const MeshNode* meshNode = NodeCast<MeshNode>(node.get()))
+        DrawMesh(meshNode->GetMeshType(), meshNode->GetMaterial().albedo, meshNode->GetGlobalTransform(),
+                 shader, uniforms, cubeVAO, planeVAO, pyramidVAO, cylinderVAO, coneVAO, sphereVAO);
 
     // Recurse children
     for (auto& c : node->children)
-        RenderNode(c, shader, cubeVAO, planeVAO, pyramidVAO, cylinderVAO, coneVAO, sphereVAO);
+        RenderNode(c, shader, uniforms, cubeVAO, planeVAO, pyramidVAO, cylinderVAO, coneVAO, sphereVAO);
 }
 
 int main() {
@@ -401,13 +690,22 @@ int main() {
         return -1;
     }
 
-    // Context: OpenGL 4.6 Core Profile
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-
     // 2. Create window
-    GLFWwindow* window = glfwCreateWindow(1280, 720, "School Scene", NULL, NULL);
+    // Context: OpenGL 4.6 Core Profile, falling back to 4.5 / 4.3 (e.g. Mesa llvmpipe on CPU-only machines)
+    struct GLVersion { int major, minor; const char* glsl; };
+    const GLVersion glVersions[] = { { 4, 6, "#version 460" }, { 4, 5, "#version 450" }, { 4, 3, "#version 430" } };
+    GLFWwindow* window = NULL;
+    const char* glslVersion = NULL;
+    for (const GLVersion& version : glVersions) {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, version.major);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, version.minor);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        window = glfwCreateWindow(1280, 720, "School Scene", NULL, NULL);
+        if (window != NULL) {
+            glslVersion = version.glsl;
+            break;
+        }
+    }
     if (window == NULL) {
         std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
@@ -437,12 +735,33 @@ int main() {
     ImGui::StyleColorsDark();
 
     ImGui_ImplGlfw_InitForOpenGL(window, true);
-    ImGui_ImplOpenGL3_Init("#version 460");
+    ImGui_ImplOpenGL3_Init(glslVersion);
 
     // Build resources: shader, geometry VAO and the school scene
     // Load shaders (paths relative to executable location)
-    Shader sceneShader("shaders/scene.vs", "shaders/scene_lighting.fs");
+    // Point lights: the uniform block (brute-force path) is sized to the largest block this
+    // driver supports; clustered shading reads every light from the light texture buffer.
+    constexpr size_t kMaxSceneLights = 4096;
+    LightManager lightManager(kMaxSceneLights);
+    const std::string sceneDefines =
+        "#define MAX_POINT_LIGHTS " + std::to_string(lightManager.GetUniformCapacity()) + "\n" +
+        "#define CLUSTER_GRID_X " + std::to_string(LightClusterer::kGridX) + "\n" +
+        "#define CLUSTER_GRID_Y " + std::to_string(LightClusterer::kGridY) + "\n" +
+        "#define CLUSTER_GRID_Z " + std::to_string(LightClusterer::kGridZ) + "\n";
+    Shader sceneShader("shaders/scene.vs", "shaders/scene_lighting.fs", sceneDefines);
     Shader skyboxShader("shaders/scene.vs", "shaders/skybox_blend.fs");
+    const SceneUniforms sceneUniforms(sceneShader);
+
+    sceneShader.BindUniformBlock("PointLightBlock", LightManager::kBindingPoint);
+    sceneShader.Use();
+    sceneShader.Set(sceneUniforms.pointLightData, static_cast<int>(LightManager::kLightTextureUnit));
+    sceneShader.Set(sceneUniforms.clusterGrid, static_cast<int>(LightClusterer::kGridTextureUnit));
+    sceneShader.Set(sceneUniforms.clusterLightIndices, static_cast<int>(LightClusterer::kIndexTextureUnit));
+    AddSchoolLights(lightManager);
+
+    LightClusterer lightClusterer;
+    lightClusterer.SetDepthRange(0.5f, 100.0f); // scene projection far plane is 100
+
     // Create cube VAO 
     GLuint cubeVAO = createCubeVAO();
     // Create plane VAO
@@ -456,10 +775,43 @@ int main() {
     // Create sphere VAO for sun and moon
     GLuint sphereVAO = createSphereVAO();
 
+    // Indexed primitives: vertices saved by welding and vertex cache misses per triangle (ACMR)
+    {
+        const std::pair<const char*, MeshData> primitives[] = {
+            { "Cube", buildCubeMesh() }, { "Plane", buildPlaneMesh() }, { "Pyramid", buildPyramidMesh() },
+            { "Cylinder", buildCylinderMesh() }, { "Cone", buildConeMesh() }, { "Sphere", buildSphereMesh() },
+        };
+        for (const auto& [name, mesh] : primitives)
+        {
+            std::cout << name << ": " << mesh.soupVertexCount << " -> " << mesh.GetVertexCount() << " vertices ("
+                      << mesh.soupVertexCount - mesh.GetVertexCount() << " saved), ACMR "
+                      << mesh.acmrBefore << " -> " << mesh.acmrAfter << std::endl;
+        }
+    }
+
+    // Instanced renderer shares the mesh VAOs (adds per-instance attributes 3..7)
+    InstancedRenderer instancedRenderer;
+    instancedRenderer.RegisterMesh(MeshType::Cube, cubeVAO, kCubeIndexCount);
+    instancedRenderer.RegisterMesh(MeshType::Plane, planeVAO, kPlaneIndexCount);
+    instancedRenderer.RegisterMesh(MeshType::Pyramid, pyramidVAO, kPyramidIndexCount);
+    instancedRenderer.RegisterMesh(MeshType::Cylinder, cylinderVAO, kCylinderIndexCount);
+    instancedRenderer.RegisterMesh(MeshType::Cone, coneVAO, kConeIndexCount);
+    instancedRenderer.RegisterMesh(MeshType::Sphere, sphereVAO, kSphereIndexCount);
+
     // Build school scene
     auto root = SchoolBuilder::generateSchool(1.0f);
-    // Ensure transforms are propagated (just in case SchoolBuilder didn't do it)
-    root->updateGlobalTransform();
+    {
+        const SceneArena::MemoryStats arenaStats = SceneArena::Get().GetMemoryStats();
+        std::cout << "Scene arena: " << arenaStats.liveNodes << " nodes, " << arenaStats.reservedBytes / 1024
+                  << " KB reserved, " << arenaStats.bytesPerNode << " B/node (separate shared_ptr allocations: ~"
+                  << arenaStats.sharedPtrBytesPerNode << " B/node)" << std::endl;
+    }
+
+    // Compile the scene into a flat depth-first transform store; from here on the
+    // global-transform pass is a linear sweep instead of a recursive tree walk.
+    TransformHierarchy transformHierarchy;
+    transformHierarchy.Build(root);
+    transformHierarchy.UpdateGlobalTransforms();
     
     // Setup control panel button bounds for ray casting (no rotation - facing outward)
     glm::mat4 pXform = glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, 0.0f, 22.0f));
@@ -478,9 +830,28 @@ int main() {
     // --- PARTICLE SYSTEM SETUP ---
     // Use relative paths for portability across different machines
     Shader particleShader("shaders/particle.vs", "shaders/particle.fs");
-    ParticleSystem fountainParticles(1000); // 1000 particles
+    const Uniform<glm::mat4> particleProjection = particleShader.GetUniform<glm::mat4>("projection");
+    const Uniform<glm::mat4> particleView = particleShader.GetUniform<glm::mat4>("view");
+    const Uniform<glm::mat4> particleModel = particleShader.GetUniform<glm::mat4>("model");
+    const Uniform<glm::vec3> particleOrigin = particleShader.GetUniform<glm::vec3>("particleOrigin");
+    // One shared pool for every emitter (the fountain alone needs ~1200)
+    constexpr unsigned int kMaxParticles = 65536;
+    ParticleManager particleManager(kMaxParticles);
     // Spawn at fountain top: (28.0, 6.8, 18.0)
-    fountainParticles.SpawnPosition = glm::vec3(28.0f, 6.8f, 18.0f);
+    const glm::vec3 fountainTop(28.0f, 6.8f, 18.0f);
+    particleManager.AddEmitter(MakeFountainEmitter(fountainTop));
+
+    // Worker pool: particle integration runs there while the scene is submitted
+    JobSystem jobSystem(static_cast<unsigned int>(g_workerThreadCount));
+
+    // Same fountain simulated by a compute shader; draws straight from its storage buffer
+    std::unique_ptr<GpuParticleSystem> gpuFountainParticles;
+    std::unique_ptr<Shader> gpuParticleShader;
+    if (GpuParticleSystem::IsSupported()) {
+        gpuFountainParticles = std::make_unique<GpuParticleSystem>(1000);
+        gpuFountainParticles->SpawnPosition = fountainTop;
+        gpuParticleShader = std::make_unique<Shader>("shaders/particle_gpu.vs", "shaders/particle.fs");
+    }
     
     // Disable default water jets blocks to avoid visual clash?
     // We can keep them as "core" water, and particles are "spray".
@@ -501,6 +872,83 @@ int main() {
     CollectColliders(root, staticWorldColliders, excludedDoorNodes);
     std::cout << "Collected " << staticWorldColliders.size() << " static collider boxes." << std::endl;
 
+    // Layered collision world: the static colliders are indexed once, doors and the gate get
+    // persistent dynamic slots that are updated in place every frame (no per-frame copies)
+    CollisionWorld collisionWorld;
+    collisionWorld.SetStatic(staticWorldColliders);
+
+    // Particles bounce off the same static boxes (point lookups in the grid, safe on the workers)
+    particleManager.SetColliders(&collisionWorld.GetStaticLayer());
+
+    struct DoorCollider
+    {
+        size_t doorIndex; // into SchoolBuilder::s_doors
+        MeshNode::Ptr mesh;
+        CollisionWorld::DynamicHandle handle;
+    };
+    std::vector<DoorCollider> doorColliders;
+    for (size_t i = 0; i < SchoolBuilder::s_doors.size(); ++i) {
+        for (auto& child : SchoolBuilder::s_doors[i].node->children) {
+            if (auto mesh = NodeCast<MeshNode>(child)) {
+                doorColliders.push_back({ i, mesh, collisionWorld.AddDynamic(GetAABBFromTransform(mesh->GetGlobalTransform())) });
+            }
+        }
+    }
+
+    // Gate is at Z = 30.0, spanning X from -5 to +5 (10m total width)
+    // Height: 3m, Thickness: ~0.1m
+    AABB leftGateBox;
+    leftGateBox.min = glm::vec3(-5.0f, 0.0f, 29.95f);
+    leftGateBox.max = glm::vec3(0.0f, 3.0f, 30.05f);
+    AABB rightGateBox;
+    rightGateBox.min = glm::vec3(0.0f, 0.0f, 29.95f);
+    rightGateBox.max = glm::vec3(5.0f, 3.0f, 30.05f);
+    const CollisionWorld::DynamicHandle leftGateCollider = collisionWorld.AddDynamic(leftGateBox);
+    const CollisionWorld::DynamicHandle rightGateCollider = collisionWorld.AddDynamic(rightGateBox);
+
+    // Ray queries (picking): BVH over every mesh; animated subtrees go to the per-frame dynamic layer
+    std::vector<SceneNode::Ptr> dynamicRoots;
+    dynamicRoots.insert(dynamicRoots.end(), SchoolBuilder::s_people.begin(), SchoolBuilder::s_people.end());
+    dynamicRoots.insert(dynamicRoots.end(), SchoolBuilder::s_birds.begin(), SchoolBuilder::s_birds.end());
+    dynamicRoots.insert(dynamicRoots.end(), SchoolBuilder::s_clouds.begin(), SchoolBuilder::s_clouds.end());
+    for (const auto& car : SchoolBuilder::s_cars) dynamicRoots.push_back(car.node);
+    for (const auto& door : SchoolBuilder::s_doors) dynamicRoots.push_back(door.node);
+    for (const auto& part : SchoolBuilder::s_flagParts) dynamicRoots.push_back(part.node);
+    dynamicRoots.push_back(SchoolBuilder::s_clock);
+    dynamicRoots.push_back(SchoolBuilder::s_schoolGateLeft);
+    dynamicRoots.push_back(SchoolBuilder::s_schoolGateRight);
+    dynamicRoots.push_back(SchoolBuilder::s_gateLever);
+
+    SceneBVH sceneBVH;
+    sceneBVH.Build(root, dynamicRoots);
+    std::cout << "Scene BVH: " << sceneBVH.GetStaticCount() << " static, " << sceneBVH.GetDynamicCount() << " dynamic meshes." << std::endl;
+
+    // Static batching: everything outside the animated subtrees is merged into one buffer, one draw per albedo
+    StaticBatcher staticBatcher;
+    staticBatcher.Bake(root, dynamicRoots);
+    const std::vector<SceneNode::Ptr> wholeScene = { root };
+    const MeshTable& meshTable = MeshTable::Get();
+    std::vector<SceneNode*> visibleNodes; // frustum culling output, reused every frame
+    std::cout << "Static batching: " << staticBatcher.GetStaticMeshCount() << " static meshes -> "
+              << staticBatcher.GetBucketCount() << " draws (" << staticBatcher.GetVertexCount() << " vertices, "
+              << staticBatcher.GetBufferBytes() / 1024 << " KB); per-node draws before: "
+              << staticBatcher.GetStaticMeshCount() + staticBatcher.GetDynamicMeshCount() << ", after: "
+              << staticBatcher.GetBucketCount() + staticBatcher.GetDynamicMeshCount() << std::endl;
+
+    // Occlusion culling: the big static pieces are rasterized into a small CPU depth buffer each frame
+    OcclusionCuller occlusionCuller;
+    {
+        std::vector<const SceneNode*> occluders;
+        CollectOccluders(root, occluders);
+        occlusionCuller.SetOccluders(std::move(occluders));
+    }
+    std::vector<uint8_t> occlusionImage;
+    GLuint occlusionTexture = 0; // debug view, created on first use
+    std::cout << "Occlusion culling: " << occlusionCuller.GetOccluderCount() << " occluders." << std::endl;
+
+    // Door meshes -> door index, so a picked mesh can be mapped back to its door
+    std::unordered_map<const MeshNode*, size_t> doorByMesh;
+    for (const auto& dc : doorColliders) doorByMesh[dc.mesh.get()] = dc.doorIndex;
 
     // Timing variables for delta time
     float lastFrame = 0.0f;
@@ -513,6 +961,8 @@ int main() {
 
     // 5. Main render loop
     while (!glfwWindowShouldClose(window)) {
+        g_transformsRecomputed = 0;
+
         // Per-frame time logic
         float currentFrame = static_cast<float>(glfwGetTime());
         deltaTime = currentFrame - lastFrame;
@@ -526,57 +976,40 @@ int main() {
             glfwSetWindowShouldClose(window, true);
 
         // Update global transforms for correct collision/interaction
-        root->updateGlobalTransform();
-
-        // --- DYNAMIC COLLISION SETUP ---
-        // Combine static world with current closed doors
-        std::vector<AABB> currentFrameColliders = staticWorldColliders;
-        
-        // Add CLOSED doors to collision list
-        for (const auto& door : SchoolBuilder::s_doors) {
-            // Treat as solid if closed or barely open (< 45 degrees)
-            if (std::abs(door.currentAngle) < 45.0f) {
-                 for (auto& child : door.node->children) {
-                     if (auto mesh = std::dynamic_pointer_cast<MeshNode>(child)) {
-                         // Get world-space AABB of the door leaf/knob
-                         AABB childBox = GetAABBFromTransform(mesh->GetGlobalTransform());
-                         currentFrameColliders.push_back(childBox);
-                     }
-                 }
+        g_transformsRecomputed += transformHierarchy.UpdateGlobalTransforms();
+
+        // --- DYNAMIC COLLISION UPDATE ---
+        // Doors are solid if closed or barely open (< 45 degrees)
+        for (const auto& dc : doorColliders) {
+            const bool solid = std::abs(SchoolBuilder::s_doors[dc.doorIndex].currentAngle) < 45.0f;
+            collisionWorld.SetDynamicEnabled(dc.handle, solid);
+            if (solid) {
+                // World-space AABB of the door leaf/knob
+                collisionWorld.SetDynamic(dc.handle, GetAABBFromTransform(dc.mesh->GetGlobalTransform()));
             }
         }
-        
-        // Add CLOSED GATE to collision list
-        if (!SchoolBuilder::s_isGateOpen) {
-            // Gate is at Z = 30.0, spanning X from -5 to +5 (10m total width)
-            // Height: 3m, Thickness: ~0.1m
-            AABB leftGateBox;
-            leftGateBox.min = glm::vec3(-5.0f, 0.0f, 29.95f);
-            leftGateBox.max = glm::vec3(0.0f, 3.0f, 30.05f);
-            currentFrameColliders.push_back(leftGateBox);
-            
-            AABB rightGateBox;
-            rightGateBox.min = glm::vec3(0.0f, 0.0f, 29.95f);
-            rightGateBox.max = glm::vec3(5.0f, 3.0f, 30.05f);
-            currentFrameColliders.push_back(rightGateBox);
-        }
 
-        // Toggle Door (Mouse Click when near)
+        // Closed gate blocks the entrance
+        collisionWorld.SetDynamicEnabled(leftGateCollider, !SchoolBuilder::s_isGateOpen);
+        collisionWorld.SetDynamicEnabled(rightGateCollider, !SchoolBuilder::s_isGateOpen);
+
+        // Pick what the crosshair is looking at (BVH ray query)
+        sceneBVH.UpdateDynamic();
+        const auto pickStart = std::chrono::steady_clock::now();
+        RayHit lookHit;
+        const bool lookingAtSomething = sceneBVH.Raycast(g_player.GetPosition(), g_player.GetFront(), 50.0f, lookHit);
+        g_pickQueryUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - pickStart).count();
+
+        // Toggle Door (Mouse Click when looking at one within reach)
         static bool mousePressedLast = false;
         bool mousePressed = (glfwGetMouseButton(window, GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS);
         
-        // Check for interaction (extended distance)
         float interactionDist = 4.0f; 
         SchoolBuilder::Door* nearestDoor = nullptr;
-        float minDist = interactionDist;
-        
-        for (auto& door : SchoolBuilder::s_doors) {
-            // Get global position of the door hinge
-            glm::vec3 doorPos = glm::vec3(door.node->GetGlobalTransform()[3]);
-            float dist = glm::distance(g_player.GetPosition(), doorPos);
-            if (dist < minDist) {
-                minDist = dist;
-                nearestDoor = &door;
+        if (lookingAtSomething && lookHit.distance < interactionDist) {
+            auto it = doorByMesh.find(lookHit.node);
+            if (it != doorByMesh.end()) {
+                nearestDoor = &SchoolBuilder::s_doors[it->second];
             }
         }
         
@@ -588,7 +1021,7 @@ int main() {
         mousePressedLast = mousePressed;
 
         // Forward keyboard movement to player controller
-        g_player.ProcessInputs(window, deltaTime, currentFrameColliders);
+        g_player.ProcessInputs(window, deltaTime, collisionWorld);
         processLightingInput(window); // Separate lighting keys
 
         
@@ -630,6 +1063,85 @@ int main() {
         static float clear_color[4] = { 0.45f, 0.55f, 0.60f, 1.00f };
         ImGui::ColorEdit3("Clear Color", clear_color);
         ImGui::Text("FPS: %.1f", io.Framerate);
+        ImGui::Checkbox("Instanced Rendering", &g_useInstancing);
+        ImGui::Checkbox("Frustum Culling", &g_useFrustumCulling);
+        if (g_useFrustumCulling)
+        {
+            ImGui::Text("Culling: %zu tests, %zu culled, %zu drawn", g_cullStats.tested, g_cullStats.culled, g_cullStats.drawn);
+            ImGui::Checkbox("Occlusion Culling", &g_useOcclusionCulling);
+            if (g_useOcclusionCulling)
+            {
+                ImGui::Text("Occluders: %zu / %zu (%zu triangles, %.3f ms), %zu meshes hidden",
+                            occlusionCuller.GetRenderedOccluderCount(), occlusionCuller.GetOccluderCount(),
+                            occlusionCuller.GetTriangleCount(), occlusionCuller.GetLastRenderMs(), g_cullStats.occluded);
+                ImGui::Checkbox("Show Occlusion Buffer", &g_showOcclusionBuffer);
+                if (g_showOcclusionBuffer)
+                {
+                    occlusionCuller.GetDebugImage(occlusionImage);
+                    if (occlusionTexture == 0)
+                    {
+                        glGenTextures(1, &occlusionTexture);
+                        glBindTexture(GL_TEXTURE_2D, occlusionTexture);
+                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+                        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, OcclusionCuller::kWidth, OcclusionCuller::kHeight, 0,
+                                     GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+                    }
+                    glBindTexture(GL_TEXTURE_2D, occlusionTexture);
+                    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, OcclusionCuller::kWidth, OcclusionCuller::kHeight,
+                                    GL_RGBA, GL_UNSIGNED_BYTE, occlusionImage.data());
+                    glBindTexture(GL_TEXTURE_2D, 0);
+                    // Rows are stored bottom first: flip v
+                    ImGui::Image((ImTextureID)(intptr_t)occlusionTexture, ImVec2(512.0f, 256.0f), ImVec2(0, 1), ImVec2(1, 0));
+                }
+            }
+        }
+        ImGui::Checkbox("Static Batching", &g_useStaticBatching);
+        ImGui::SameLine();
+        ImGui::TextDisabled("(%zu meshes -> %zu draws)", staticBatcher.GetStaticMeshCount(), staticBatcher.GetBucketCount());
+        ImGui::Text("Scene Draw Calls: %zu", g_drawCallCount);
+        ImGui::Text("Transforms Recomputed: %zu / %zu", g_lastFrameTransformsRecomputed, transformHierarchy.Size());
+        ImGui::Text("Point Lights: %zu / %zu (last upload %zu B)", lightManager.Size(), lightManager.Capacity(), lightManager.GetLastUploadBytes());
+        if (lookingAtSomething)
+            ImGui::Text("Pick: %.2f m, normal (%.2f, %.2f, %.2f), %.1f us", lookHit.distance,
+                        lookHit.normal.x, lookHit.normal.y, lookHit.normal.z, g_pickQueryUs);
+        else
+            ImGui::Text("Pick: nothing, %.1f us", g_pickQueryUs);
+        if (gpuFountainParticles)
+            ImGui::Checkbox("GPU Particles (compute)", &g_useGpuParticles);
+        else
+            ImGui::Text("GPU Particles: needs OpenGL 4.3");
+        if (!g_useGpuParticles)
+        {
+            if (ImGui::SliderInt("Stress Emitters", &g_stressEmitterCount, 0, 200))
+            {
+                particleManager.ClearEmitters();
+                particleManager.AddEmitter(MakeFountainEmitter(fountainTop));
+                AddStressEmitters(particleManager, g_stressEmitterCount);
+            }
+            if (ImGui::SliderInt("Worker Threads", &g_workerThreadCount, 0, static_cast<int>(std::thread::hardware_concurrency())))
+                jobSystem.SetWorkerCount(static_cast<unsigned int>(g_workerThreadCount));
+            ImGui::Text("CPU Particles: %u / %u live, %zu emitters (%s)", particleManager.GetLiveCount(),
+                        particleManager.GetCapacity(), particleManager.GetEmitterCount(), ParticleKernels::GetSimdName());
+        }
+        ImGui::Checkbox("Clustered Lighting", &g_useClusteredLighting);
+        if (ImGui::SliderInt("Stress Lights", &g_stressLightCount, 0, static_cast<int>(kMaxSceneLights) - 64))
+        {
+            lightManager.Clear();
+            AddSchoolLights(lightManager);
+            AddStressLights(lightManager, g_stressLightCount);
+        }
+        if (g_useClusteredLighting)
+        {
+            ImGui::Text("Cluster Build: %.3f ms", lightClusterer.GetLastBuildMs());
+            ImGui::Text("Light Indices: %zu (max %u per cluster, %u / %u clusters lit)",
+                        lightClusterer.GetIndexCount(), lightClusterer.GetMaxLightsPerCluster(),
+                        lightClusterer.GetOccupiedClusterCount(), LightClusterer::kClusterCount);
+        }
+        else if (lightManager.Size() > lightManager.GetUniformCapacity())
+        {
+            ImGui::Text("Brute force: only the first %zu lights are shaded", lightManager.GetUniformCapacity());
+        }
         ImGui::End();
 
         // Render
@@ -649,20 +1161,13 @@ int main() {
             ImGui::End();
         }
         
-        // Door Interaction Prompt
-        // Use the same nearestDoor logic (re-calculated or cached? Re-calc is cheap)
-        interactionDist = 3.0f;
-        for (auto& door : SchoolBuilder::s_doors) {
-            glm::vec3 doorPos = glm::vec3(door.node->GetGlobalTransform()[3]);
-            float dist = glm::distance(g_player.GetPosition(), doorPos);
-            if (dist < interactionDist) {
-                 ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x / 2.0f, ImGui::GetIO().DisplaySize.y / 2.0f + 60.0f), ImGuiCond_Always, ImVec2(0.5f, 0.0f));
-                 ImGui::SetNextWindowBgAlpha(0.6f);
-                 ImGui::Begin("DoorPrompt", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
-                 ImGui::Text("Click chuot trai de %s Cua", door.isOpen ? "Dong" : "Mo");
-                 ImGui::End();
-                 break; // Only show for one
-            }
+        // Door Interaction Prompt (same picked door as the click logic)
+        if (nearestDoor) {
+             ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x / 2.0f, ImGui::GetIO().DisplaySize.y / 2.0f + 60.0f), ImGuiCond_Always, ImVec2(0.5f, 0.0f));
+             ImGui::SetNextWindowBgAlpha(0.6f);
+             ImGui::Begin("DoorPrompt", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav);
+             ImGui::Text("Click chuot trai de %s Cua", nearestDoor->isOpen ? "Dong" : "Mo");
+             ImGui::End();
         }
 
         ImGui::Render();
@@ -681,8 +1186,8 @@ int main() {
                                                 display_w > 0 ? static_cast<float>(display_w) / static_cast<float>(display_h) : 1.0f,
                                                 0.1f, 100.0f);
 
-        sceneShader.SetMat4("view", view);
-        sceneShader.SetMat4("projection", projection);
+        sceneShader.Set(sceneUniforms.view, view);
+        sceneShader.Set(sceneUniforms.projection, projection);
 
         // Animate sun and moon in VERTICAL orbit (perpendicular - up and down)
         float orbitRadius = 80.0f;  // Extremely large orbit
@@ -710,10 +1215,10 @@ int main() {
         glm::vec3 sunColor = glm::vec3(1.0f, 0.95f, 0.7f);
         float sunIntensity = isDay ? (1.5f * (sunY / orbitRadius)) : 0.0f; // Intensity based on height
         
-        sceneShader.SetMat4("sunModel", sunModel);
-        sceneShader.SetVec3("sunColor", sunColor);
-        sceneShader.SetFloat("sunIntensity", sunIntensity);
-        sceneShader.SetVec3("sceneCenter", sceneCenter);
+        sceneShader.Set(sceneUniforms.sunModel, sunModel);
+        sceneShader.Set(sceneUniforms.sunColor, sunColor);
+        sceneShader.Set(sceneUniforms.sunIntensity, sunIntensity);
+        sceneShader.Set(sceneUniforms.sceneCenter, sceneCenter);
         
         // Adjust ambient light based on time of day (more dramatic difference)
         glm::vec3 ambientColor;
@@ -722,7 +1227,7 @@ int main() {
         } else {
             ambientColor = glm::vec3(0.00008f, 0.00008f, 0.0001f); // 10x darker (Night)
         }
-        sceneShader.SetVec3("ambientColor", ambientColor);
+        sceneShader.Set(sceneUniforms.ambientColor, ambientColor);
         
         // === DIRECTIONAL LIGHTS FROM SUN AND MOON ===
         // These lights move with the sun/moon to simulate them emitting light
@@ -732,141 +1237,36 @@ int main() {
         glm::vec3 sunLightColor = glm::vec3(1.0f, 0.95f, 0.8f); // Warm yellow-white
         float sunLightIntensity = isDay ? (2.5f * (sunY / orbitRadius)) : 0.0f; // Increased from 1.001 to 2.5
         
-        sceneShader.SetVec3("sunLightDirection", sunLightDir);
-        sceneShader.SetVec3("sunLightColor", sunLightColor);
-        sceneShader.SetFloat("sunLightIntensity", sunLightIntensity);
+        sceneShader.Set(sceneUniforms.sunLightDirection, sunLightDir);
+        sceneShader.Set(sceneUniforms.sunLightColor, sunLightColor);
+        sceneShader.Set(sceneUniforms.sunLightIntensity, sunLightIntensity);
         
         // Moon directional light (only active at night) - Increased intensity for visibility
         glm::vec3 moonLightDir = -glm::normalize(moonPos); // Direction FROM moon (negative to shine downward)
         glm::vec3 moonLightColor = glm::vec3(0.7f, 0.8f, 1.0f); // Cool blue-white
         float moonLightIntensity = !isDay ? (2.5f * (moonY / orbitRadius)) : 0.0f; // Increased from 1.001 to 2.5
         
-        sceneShader.SetVec3("moonLightDirection", moonLightDir);
-        sceneShader.SetVec3("moonLightColor", moonLightColor);
-        sceneShader.SetFloat("moonLightIntensity", moonLightIntensity);
-        
-        // Set up all point lights: 10 central + 6 perimeter + 3 statue + 3 fountain + 4 corners + 12 horizontal path + 1 gate = 39 total
-        // Point lights are ALWAYS ON with constant brightness
-        int totalLights = 39; // Updated for gate highlight light
-        float lightHeight = 4.0f;
-        sceneShader.SetInt("numPointLights", totalLights);
-        
-        // Light multiplier based on toggle state and brightness
-        float lightMultiplier = g_lightsEnabled ? g_lightBrightness : 0.0f;
-        
-        // Central pathway lights (10 lights in 5 symmetric pairs) - CONSTANT BRIGHTNESS
-        int numPairs = 5;
-        float spacing = 7.0f;
-        for (int i = 0; i < numPairs; ++i)
-        {
-            float z = 28.0f - i * spacing; // Z positions: 28, 21, 14, 7, 0
-            
-            // Left light - ALWAYS 3.5 intensity
-            std::string baseNameL = "pointLights[" + std::to_string(i * 2) + "]";
-            sceneShader.SetVec3(baseNameL + ".position", glm::vec3(-2.5f, lightHeight, z));
-            sceneShader.SetVec3(baseNameL + ".color", glm::vec3(1.0f, 0.9f, 0.7f));
-            sceneShader.SetFloat(baseNameL + ".intensity", 3.5f * lightMultiplier); // Toggle-able
-            
-            // Right light - ALWAYS 3.5 intensity
-            std::string baseNameR = "pointLights[" + std::to_string(i * 2 + 1) + "]";
-            sceneShader.SetVec3(baseNameR + ".position", glm::vec3(2.5f, lightHeight, z));
-            sceneShader.SetVec3(baseNameR + ".color", glm::vec3(1.0f, 0.9f, 0.7f));
-            sceneShader.SetFloat(baseNameR + ".intensity", 3.5f * lightMultiplier); // Toggle-able
-        }
-        
-        // Perimeter lights (6 lights around school - outside sports courts) - CONSTANT BRIGHTNESS
-        glm::vec3 perimeterLightPositions[] = {
-            glm::vec3(-32.0f, lightHeight, 0.0f),    // Left side 1 (outside basketball court)
-            glm::vec3(-39.0f, lightHeight, -15.0f),  // Left side 2 (adjusted by user)
-            glm::vec3(32.0f, lightHeight, 0.0f),     // Right side 1 (outside football field)
-            glm::vec3(39.0f, lightHeight, -15.0f),   // Right side 2 (adjusted by user)
-            glm::vec3(-15.0f, lightHeight, -20.0f),  // Back left
-            glm::vec3(15.0f, lightHeight, -20.0f)    // Back right
-        };
-        
-        for (int i = 0; i < 6; ++i)
-        {
-            std::string baseName = "pointLights[" + std::to_string(10 + i) + "]"; // Start from index 10 (after 10 pathway lights)
-            sceneShader.SetVec3(baseName + ".position", perimeterLightPositions[i]);
-            sceneShader.SetVec3(baseName + ".color", glm::vec3(1.0f, 0.9f, 0.7f));
-            sceneShader.SetFloat(baseName + ".intensity", 4.0f * lightMultiplier); // Toggle-able
-        }
-        
-        // Statue spotlights (3 lights around statue) - CONSTANT BRIGHTNESS
-        // Statue is at position (-28, 0, 18), scaled 2.0x (in left front corner)
-        glm::vec3 statueLightPositions[] = {
-            glm::vec3(-28.0f, 5.0f, 21.0f),   // Front light (elevated for 2x scale)
-            glm::vec3(-25.0f, 6.0f, 18.0f),   // Right side light (higher)
-            glm::vec3(-31.0f, 5.0f, 15.0f)    // Back left light
-        };
-        
-        for (int i = 0; i < 3; ++i)
-        {
-            std::string baseName = "pointLights[" + std::to_string(16 + i) + "]"; // Start from index 16 (after 10 pathway + 6 perimeter)
-            sceneShader.SetVec3(baseName + ".position", statueLightPositions[i]);
-            sceneShader.SetVec3(baseName + ".color", glm::vec3(1.0f, 0.95f, 0.8f)); // Warm golden light
-            sceneShader.SetFloat(baseName + ".intensity", 5.0f * lightMultiplier); // Toggle-able
-        }
-        
-        // Fountain underwater lights (3 lights around fountain base) - CONSTANT BRIGHTNESS
-        // Fountain is at position (28, 0, 18), scaled 1.5x (in right front corner)
-        glm::vec3 fountainLightPositions[] = {
-            glm::vec3(28.0f, 1.0f, 21.5f),    // Front light (low, underwater effect)
-            glm::vec3(31.0f, 1.5f, 18.0f),    // Right side light
-            glm::vec3(25.0f, 1.0f, 14.5f)     // Back left light
-        };
-        
-        for (int i = 0; i < 3; ++i)
-        {
-            std::string baseName = "pointLights[" + std::to_string(19 + i) + "]"; // Start from index 19 (after statue)
-            sceneShader.SetVec3(baseName + ".position", fountainLightPositions[i]);
-            sceneShader.SetVec3(baseName + ".color", glm::vec3(0.7f, 0.9f, 1.0f)); // Cool blue-white water light
-            sceneShader.SetFloat(baseName + ".intensity", 4.5f * lightMultiplier); // Toggle-able
-        }
-        
-        // Corner lights (4 lights at school corners for better coverage)
-        glm::vec3 cornerLightPositions[] = {
-            glm::vec3(-35.0f, 5.0f, -20.0f),  // Back left corner
-            glm::vec3(35.0f, 5.0f, -20.0f),   // Back right corner
-            glm::vec3(-35.0f, 5.0f, 25.0f),   // Front left corner
-            glm::vec3(35.0f, 5.0f, 25.0f)     // Front right corner
-        };
+        sceneShader.Set(sceneUniforms.moonLightDirection, moonLightDir);
+        sceneShader.Set(sceneUniforms.moonLightColor, moonLightColor);
+        sceneShader.Set(sceneUniforms.moonLightIntensity, moonLightIntensity);
         
-        for (int i = 0; i < 4; ++i)
+        // Point lights are static: only the global switch/brightness changes at runtime,
+        // which re-uploads the 16-byte block header and nothing else.
+        lightManager.SetIntensityScale(g_lightsEnabled ? g_lightBrightness : 0.0f);
+        lightManager.Upload();
+        lightManager.Bind();
+
+        // Clustered lighting: rebuild the per-cluster light lists for this camera
+        sceneShader.Set(sceneUniforms.useClusteredLighting, g_useClusteredLighting);
+        if (g_useClusteredLighting)
         {
-            std::string baseName = "pointLights[" + std::to_string(22 + i) + "]"; // Start from index 22 (after fountain)
-            sceneShader.SetVec3(baseName + ".position", cornerLightPositions[i]);
-            sceneShader.SetVec3(baseName + ".color", glm::vec3(1.0f, 0.9f, 0.7f)); // Warm white
-            sceneShader.SetFloat(baseName + ".intensity", 5.0f * lightMultiplier); // Toggle-able, bright
+            lightClusterer.Build(lightManager.GetLights(), lightManager.GetIntensityScale(), view, projection);
+            lightClusterer.Bind();
+            sceneShader.Set(sceneUniforms.clusterScreenSize, glm::vec2(static_cast<float>(display_w), static_cast<float>(display_h)));
+            sceneShader.Set(sceneUniforms.clusterSliceScale, lightClusterer.GetSliceScale());
+            sceneShader.Set(sceneUniforms.clusterSliceBias, lightClusterer.GetSliceBias());
         }
 
-        // Horizontal Pathway Lights (Expanded to cover 100m road)
-        // Positions matches SchoolBuilder: X from -45 to 45 step 15, Z = 40 +/- 6
-        float hLightZ = 40.0f;
-        int lightIdx = 26; // Start after previous 26 lights
-        
-        for (float x = -45.0f; x <= 45.0f; x += 15.0f) {
-            if (std::abs(x) < 1.0f) continue; // Skip center light
-            
-            // Front side light (Z = 46)
-            std::string nameF = "pointLights[" + std::to_string(lightIdx++) + "]";
-            sceneShader.SetVec3(nameF + ".position", glm::vec3(x, lightHeight, hLightZ + 6.0f));
-            sceneShader.SetVec3(nameF + ".color", glm::vec3(1.0f, 0.9f, 0.7f));
-            sceneShader.SetFloat(nameF + ".intensity", 3.5f * lightMultiplier);
-
-            // Back side light (Z = 34)
-            std::string nameB = "pointLights[" + std::to_string(lightIdx++) + "]";
-            sceneShader.SetVec3(nameB + ".position", glm::vec3(x, lightHeight, hLightZ - 6.0f));
-            sceneShader.SetVec3(nameB + ".color", glm::vec3(1.0f, 0.9f, 0.7f));
-            sceneShader.SetFloat(nameB + ".intensity", 3.5f * lightMultiplier);
-        }
-
-        // Gate Highlight Light (One bright light in front of the gate)
-        std::string nameGate = "pointLights[" + std::to_string(lightIdx++) + "]";
-        sceneShader.SetVec3(nameGate + ".position", glm::vec3(0.0f, 6.0f, 38.0f)); // High up, front of gate
-        sceneShader.SetVec3(nameGate + ".color", glm::vec3(1.0f, 0.98f, 0.9f)); // Very bright warm white
-        sceneShader.SetFloat(nameGate + ".intensity", 8.0f * lightMultiplier); // High intensity to highlight gate
-
         // Update people animations
         SchoolBuilder::updatePeopleAnimation(root, currentFrame);
         
@@ -894,12 +1294,94 @@ int main() {
         // Update Gate Animation
         SchoolBuilder::updateGateAnimation(deltaTime);
 
-        // Update global transforms if any dynamic transforms exist (static in our simple builder)
-        root->updateGlobalTransform();
+        // Propagate this frame's animated local transforms (only dirty subtrees are recomputed)
+        g_transformsRecomputed += transformHierarchy.UpdateGlobalTransforms();
+        g_lastFrameTransformsRecomputed = g_transformsRecomputed; // the panel above is already built
+
+        // Particle integration runs on the workers while the scene is submitted (joined before drawing them)
+        const bool cpuParticles = !(g_useGpuParticles && gpuFountainParticles);
+        if (cpuParticles)
+            particleManager.BeginUpdate(deltaTime, jobSystem);
 
         // Render scene graph
-        // Render scene graph
-        RenderNode(root, sceneShader, cubeVAO, planeVAO, pyramidVAO, cylinderVAO, coneVAO, sphereVAO);
+        g_drawCallCount = 0;
+        g_cullStats = FrustumCullStats{};
+        const bool frustumCulling = g_useFrustumCulling && !transformHierarchy.Empty();
+        const Frustum viewFrustum(projection * view);
+        const bool occlusionCulling = frustumCulling && g_useOcclusionCulling && occlusionCuller.GetOccluderCount() > 0;
+        if (occlusionCulling)
+            occlusionCuller.Render(projection * view, &jobSystem);
+        const OcclusionCuller* occlusion = occlusionCulling ? &occlusionCuller : nullptr;
+
+        const bool staticBatching = g_useStaticBatching && staticBatcher.IsBaked();
+        if (staticBatching)
+            g_drawCallCount += staticBatcher.Draw(sceneShader, sceneUniforms.model, sceneUniforms.albedo,
+                                                  frustumCulling ? &viewFrustum : nullptr, occlusion);
+
+        // With batching on, only the animated subtrees are left for the per-node / instanced paths
+        const std::vector<SceneNode::Ptr>& renderRoots = staticBatching ? staticBatcher.GetDynamicRoots() : wholeScene;
+        if (frustumCulling)
+        {
+            // Hierarchical test on the subtree bounds kept by the transform hierarchy
+            // (and against the occlusion buffer, if rendered)
+            visibleNodes.clear();
+            for (const auto& node : renderRoots)
+                transformHierarchy.CullFrustum(viewFrustum, node.get(), visibleNodes, g_cullStats, occlusion);
+        }
+
+        if (g_useInstancing)
+        {
+            instancedRenderer.Begin();
+            if (frustumCulling)
+            {
+                for (SceneNode* node : visibleNodes)
+                {
+                    if (const MeshNode* meshNode = NodeCast<MeshNode>(node))
+                        instancedRenderer.Add(meshNode->GetMeshType(), meshNode->GetGlobalTransform(), meshNode->GetMaterial().albedo);
+                }
+            }
+            else
+            {
+                // Compiled subtrees are walked flat, reading mesh data from the MeshTable
+                for (const auto& node : renderRoots)
+                {
+                    if (!node->IsCompiled())
+                    {
+                        instancedRenderer.Gather(node);
+                        continue;
+                    }
+                    transformHierarchy.ForEachMesh(node.get(), [&](const glm::mat4& model, uint32_t meshId) {
+                        instancedRenderer.Add(meshTable.GetType(meshId), model, meshTable.GetMaterial(meshId).albedo);
+                    });
+                }
+            }
+            instancedRenderer.Draw(sceneShader);
+            g_drawCallCount += instancedRenderer.GetDrawCallCount();
+        }
+        else if (frustumCulling)
+        {
+            for (SceneNode* node : visibleNodes)
+            {
+                if (const MeshNode* meshNode = NodeCast<MeshNode>(node))
+                    DrawMesh(meshNode->GetMeshType(), meshNode->GetMaterial().albedo, meshNode->GetGlobalTransform(),
+                             sceneShader, sceneUniforms, cubeVAO, planeVAO, pyramidVAO, cylinderVAO, coneVAO, sphereVAO);
+            }
+        }
+        else
+        {
+            for (const auto& node : renderRoots)
+            {
+                if (!node->IsCompiled())
+                {
+                    RenderNode(node, sceneShader, sceneUniforms, cubeVAO, planeVAO, pyramidVAO, cylinderVAO, coneVAO, sphereVAO);
+                    continue;
+                }
+                transformHierarchy.ForEachMesh(node.get(), [&](const glm::mat4& model, uint32_t meshId) {
+                    DrawMesh(meshTable.GetType(meshId), meshTable.GetMaterial(meshId).albedo, model,
+                             sceneShader, sceneUniforms, cubeVAO, planeVAO, pyramidVAO, cylinderVAO, coneVAO, sphereVAO);
+                });
+            }
+        }
         
         
         // Render Sun and Moon as visible spheres (high in sky)
@@ -910,11 +1392,11 @@ int main() {
                 glm::mat4 sunSphereModel = glm::translate(glm::mat4(1.0f), sunPos);
                 sunSphereModel = glm::scale(sunSphereModel, glm::vec3(3.0f)); // Large sun
                 
-                sceneShader.SetMat4("model", sunSphereModel);
-                sceneShader.SetVec3("albedo", glm::vec3(1.0f, 1.0f, 0.6f)); // Bright yellow
+                sceneShader.Set(sceneUniforms.model, sunSphereModel);
+                sceneShader.Set(sceneUniforms.albedo, glm::vec3(1.0f, 1.0f, 0.6f)); // Bright yellow
                 
                 glBindVertexArray(sphereVAO);
-                glDrawArrays(GL_TRIANGLES, 0, 16 * 32 * 6); // lat * lon * 6 vertices per quad
+                glDrawElements(GL_TRIANGLES, kSphereIndexCount, GL_UNSIGNED_INT, nullptr);
                 glBindVertexArray(0);
             }
             
@@ -924,28 +1406,54 @@ int main() {
                 glm::mat4 moonSphereModel = glm::translate(glm::mat4(1.0f), moonPos);
                 moonSphereModel = glm::scale(moonSphereModel, glm::vec3(2.0f)); // Smaller moon
                 
-                sceneShader.SetMat4("model", moonSphereModel);
-                sceneShader.SetVec3("albedo", glm::vec3(1.0f, 1.0f, 1.0f)); // Bright white
+                sceneShader.Set(sceneUniforms.model, moonSphereModel);
+                sceneShader.Set(sceneUniforms.albedo, glm::vec3(1.0f, 1.0f, 1.0f)); // Bright white
                 
                 glBindVertexArray(sphereVAO);
-                glDrawArrays(GL_TRIANGLES, 0, 16 * 32 * 6);
+                glDrawElements(GL_TRIANGLES, kSphereIndexCount, GL_UNSIGNED_INT, nullptr);
                 glBindVertexArray(0);
             }
         }
         
         // --- DRAW PARTICLES ---
-        fountainParticles.Update(deltaTime, 10); // Spawn 10 particles per frame
-        
-        particleShader.Use();
-        particleShader.SetMat4("projection", projection);
-        particleShader.SetMat4("view", view);
-        particleShader.SetMat4("model", glm::mat4(1.0f));
-        particleShader.SetVec4("particleColor", glm::vec4(0.5f, 0.8f, 1.0f, 1.0f));
-        
-        // Enable Point Size
-        glEnable(GL_PROGRAM_POINT_SIZE);
-        fountainParticles.Draw();
-        glDisable(GL_PROGRAM_POINT_SIZE);
+        if (!cpuParticles) {
+            gpuFountainParticles->Update(deltaTime, 10); // Spawn 10 particles per frame
+
+            gpuParticleShader->Use();
+            gpuParticleShader->SetMat4("projection", projection);
+            gpuParticleShader->SetMat4("view", view);
+            gpuParticleShader->SetMat4("model", glm::mat4(1.0f));
+            gpuParticleShader->SetVec3("particleColor", glm::vec3(0.6f, 0.8f, 1.0f));
+
+            glEnable(GL_PROGRAM_POINT_SIZE);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDepthMask(GL_FALSE); // faded particles must not hide what is behind them
+            gpuFountainParticles->Draw();
+            glDepthMask(GL_TRUE);
+            glDisable(GL_BLEND);
+            glDisable(GL_PROGRAM_POINT_SIZE);
+        } else {
+            particleManager.EndUpdate();
+
+            particleShader.Use();
+            particleShader.Set(particleProjection, projection);
+            particleShader.Set(particleView, view);
+            particleShader.Set(particleModel, glm::mat4(1.0f));
+            // Half-float positions are relative to the camera, where precision matters most
+            particleManager.SetDrawOrigin(g_player.GetPosition());
+            particleShader.Set(particleOrigin, particleManager.GetDrawOrigin());
+
+            // Enable Point Size; per-particle alpha fades the particles out
+            glEnable(GL_PROGRAM_POINT_SIZE);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            glDepthMask(GL_FALSE); // faded particles must not hide what is behind them
+            particleManager.Draw();
+            glDepthMask(GL_TRUE);
+            glDisable(GL_BLEND);
+            glDisable(GL_PROGRAM_POINT_SIZE);
+        }
 
         // Render ImGui draw data
         ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
@@ -954,6 +1462,7 @@ int main() {
     }
 
     // Cleanup
+    if (occlusionTexture != 0) glDeleteTextures(1, &occlusionTexture);
     glDeleteVertexArrays(1, &cubeVAO);
     glDeleteVertexArrays(1, &planeVAO);
 